@@ -1,386 +1,1025 @@
 #include "apimanager.h"
 #include <QNetworkRequest>
+#include <QNetworkDiskCache>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QUrlQuery>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QBuffer>
+#include <QCborStreamWriter>
+#include <QCborStreamReader>
+#include <QDebug>
 #include <QDir>
 #include <QStandardPaths>
 #include <QApplication>
 #include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QMutex>
+#include <QTimer>
+#include <QPluginLoader>
+#include <QLibrary>
 #include <algorithm>
+#include <atomic>
 #include <random>
+#include "persistenceservice.h"
+#include "questionpack.h"
+#include "questionbank.h"
+#include "jsonarraystream.h"
+#include "responseparser.h"
+#include "builtinsources.h"
+
+namespace {
+
+// Each transfer gets this long, however many calls wait on it
+constexpr int RequestTimeoutMs = 10000;
+
+// Ages of a cached question set: served as it is while fresh, served and
+// refreshed in the background while stale, fetched first beyond that
+constexpr qint64 QuestionSetFreshSecs = 15 * 60;
+constexpr qint64 QuestionSetStaleSecs = 24 * 60 * 60;
+
+constexpr qint64 HttpCacheBytes = 16 * 1024 * 1024;
+
+// Question text as duplicates are told apart across providers
+QString dedupeKey(const QuestionContent& content)
+{
+    return content.question.simplified().toCaseFolded();
+}
+
+}
+
+// Lives until its result has been handled, held by the in-flight table,
+// the reply's connections and the pending parse
+struct ApiManager::PendingRequest {
+    struct Waiter {
+        int id;
+        QSharedPointer<QuestionStream> stream; // null: wants questionsFetched()
+    };
+    
+    QString key;
+    ProviderQuery query;
+    QNetworkReply* reply = nullptr;
+    QSharedPointer<ResponseParser> parser;
+    QList<Waiter> waiters; // none for a background refresh
+    qint64 bytes = 0;
+    QString error;    // why the transfer failed
+    bool timedOut = false;
+    bool fromCache = false; // answered by the HTTP cache
+    
+    // Shared with the parse pool: streams of the waiters, and what has
+    // been pushed to them so far for a stream that joins late
+    QMutex mutex;
+    QList<QSharedPointer<QuestionStream>> streams;
+    QList<QuizQuestion> pushed;
+    std::atomic<bool> abandoned{false};
+};
+
+// One fan-out fetch: a leg per provider, merged as questions arrive
+struct ApiManager::FanOut {
+    struct Leg {
+        int request = 0;
+        QSharedPointer<QuestionStream> stream;
+        ProviderLatency latency;
+        bool done = false;
+    };
+    
+    int count = 0;
+    QSharedPointer<QuestionStream> out; // null: wants questionsFetched()
+    QList<Leg> legs;
+    QList<QuizQuestion> merged;
+    QSet<QString> seen; // dedupe keys of merged
+    QElapsedTimer clock;
+};
 
 ApiManager::ApiManager(QObject *parent)
     : QObject(parent)
     , m_networkManager(new QNetworkAccessManager(this))
-    , m_timeoutTimer(new QTimer(this))
+    , m_nextRequestId(1)
     , m_isLoading(false)
+    , m_persistence(nullptr)
+    , m_customQuizFormat(QuizFileFormat::Json)
 {
-    // Connect network signals
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &ApiManager::onNetworkReplyFinished);
+    registerSource(QSharedPointer<NewsApiSource>::create());
+    registerSource(QSharedPointer<OpenTdbSource>::create());
+    registerSource(QSharedPointer<GeeksForGeeksSource>::create());
+    
+    // Provider responses are parsed off the GUI thread; a few threads are
+    // plenty for a handful of concurrent fetches
+    m_parsePool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), 4));
+    m_parsePool.setObjectName("ResponseParsers");
     
-    // Setup timeout timer
-    m_timeoutTimer->setSingleShot(true);
-    connect(m_timeoutTimer, &QTimer::timeout, this, &ApiManager::onNetworkTimeout);
+    // Responses are kept on disk and revalidated with their ETag or
+    // Last-Modified; built question sets are kept next to them
+    setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
     
-    // Initialize local questions
-    initializeDefaultQuestions();
-    initializeCppDSAQuestions();
+    // Question sets, built-in ones included, live in the process-wide
+    // QuestionBank; nothing is held per instance
 }
 
 ApiManager::~ApiManager()
 {
+    // Parses still running hold this object in their callbacks
+    m_parsePool.waitForDone();
+}
+
+int ApiManager::fetchQuestions(int count, QSharedPointer<QuestionStream> stream)
+{
+    // A fetch that falls short is made up from the local current affairs
+    // set, which is all there is while NewsAPI has no key
+    ProviderQuery query;
+    if (!providerQuery("newsapi", count, query)) {
+        return deliverCached(getLocalCurrentAffairsQuestions(count), stream, true);
+    }
+    query.fallback = [this, count]() { return getLocalCurrentAffairsQuestions(count); };
+    return fetchProvider(query, stream);
+}
+
+int ApiManager::fetchCustomQuestions()
+{
+    // Every problem listed, with the local C++/DSA set as the fallback
+    ProviderQuery query;
+    if (!providerQuery("geeksforgeeks", 0, query)) {
+        return deliverCached(getCppDSAQuestions(), QSharedPointer<QuestionStream>(), true);
+    }
+    query.fallback = [this]() { return getCppDSAQuestions(); };
+    return fetchProvider(query, QSharedPointer<QuestionStream>());
 }
 
-void ApiManager::fetchQuestions(int count)
+int ApiManager::fetchFromProviders(int count, QSharedPointer<QuestionStream> stream, int deadlineMs)
 {
-    // Fetch current affairs questions from a free API
-    // Using NewsAPI for current affairs (free tier available)
-    QString apiKey = "e5ec4a33a17848cfb982dbf3f6e650db"; // Updated with provided API key
-    QString url = QString("https://newsapi.org/v2/top-headlines?country=us&apiKey=%1&pageSize=%2")
-                  .arg(apiKey)
-                  .arg(count);
+    int id = m_nextRequestId++;
+    auto fanOut = QSharedPointer<FanOut>::create();
+    fanOut->count = count;
+    fanOut->out = stream;
+    fanOut->clock.start();
+    m_fanOuts.insert(id, fanOut);
     
-    QNetworkRequest request((QUrl(url)));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    // Every provider at once, each through the caches and the pipeline
+    // like a fetch of its own. A leg has no fallback: the local fill is
+    // the fan-out's. A provider that is not configured sends nothing.
+    for (const QString& provider : m_providers) {
+        ProviderQuery query;
+        if (!providerQuery(provider, count, query)) continue;
+        query.fallback = []() { return QList<QuizQuestion>(); };
+        
+        FanOut::Leg leg;
+        leg.latency.provider = provider;
+        leg.stream = QSharedPointer<QuestionStream>(new QuestionStream(count), &QObject::deleteLater);
+        connect(leg.stream.data(), &QuestionStream::questionsAvailable,
+                this, [this, id]() { onFanOutQuestions(id); }, Qt::QueuedConnection);
+        fanOut->legs.append(leg);
+        fanOut->legs.last().request = fetchProvider(query, leg.stream);
+    }
     
-    m_isLoading = true;
-    emit loadingStateChanged(true);
-    m_timeoutTimer->start(10000); // 10 second timeout
+    // Whatever has arrived by the deadline is what the quiz gets
+    QTimer::singleShot(fanOut->legs.isEmpty() ? 0 : deadlineMs, this, [this, id]() {
+        finishFanOut(id);
+    });
+    return id;
+}
+
+ApiManager::FanOutReport ApiManager::lastFanOutReport() const
+{
+    return m_lastFanOut;
+}
+
+bool ApiManager::addToFanOut(FanOut& fanOut, const QuestionContentPtr& content)
+{
+    if (fanOut.merged.size() >= fanOut.count) return false;
+    QString key = dedupeKey(*content);
+    if (fanOut.seen.contains(key)) return false;
     
-    QNetworkReply* reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, [this, reply, count]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-            QJsonObject response = doc.object();
-            
-            if (response["status"].toString() == "ok") {
-                QJsonArray articles = response["articles"].toArray();
-                QList<QuizQuestion> quizQuestions;
-                
-                for (int i = 0; i < qMin(articles.size(), count); ++i) {
-                    QJsonObject article = articles[i].toObject();
-                    QString title = article["title"].toString();
-                    QString description = article["description"].toString();
-                    
-                    if (!title.isEmpty() && !description.isEmpty()) {
-                        // Create question from news article
-                        QString question = QString("What is the main topic of this news: %1?").arg(title);
-                        
-                        // Create options based on the article content
-                        QStringList options;
-                        options.append("Current Affairs"); // Correct answer
-                        options.append("Sports");
-                        options.append("Entertainment");
-                        options.append("Technology");
-                        
-                        // Shuffle options
-                        std::mt19937 rng(QRandomGenerator::global()->generate());
-                        std::shuffle(options.begin(), options.end(), rng);
-                        
-                        // Determine difficulty based on title length
-                        Difficulty difficulty = Difficulty::Easy;
-                        if (title.length() > 100) {
-                            difficulty = Difficulty::Hard;
-                        } else if (title.length() > 60) {
-                            difficulty = Difficulty::Medium;
-                        }
-                        
-                        QuizQuestion quizQuestion(question, options, "Current Affairs", difficulty);
-                        quizQuestions.append(quizQuestion);
-                    }
-                }
-                
-                emit questionsFetched(quizQuestions);
+    fanOut.seen.insert(key);
+    QuizQuestion question(content);
+    fanOut.merged.append(question);
+    if (fanOut.out) {
+        fanOut.out->push(question);
+    }
+    return true;
+}
+
+void ApiManager::onFanOutQuestions(int id)
+{
+    QSharedPointer<FanOut> fanOut = m_fanOuts.value(id);
+    if (!fanOut) return;
+    
+    qint64 elapsed = fanOut->clock.elapsed();
+    bool allDone = true;
+    for (FanOut::Leg& leg : fanOut->legs) {
+        if (leg.done) continue;
+        
+        const QList<QuestionContentPtr> arrived = leg.stream->takeAvailable();
+        for (const QuestionContentPtr& content : arrived) {
+            if (leg.latency.firstQuestionMs < 0) {
+                leg.latency.firstQuestionMs = elapsed;
+            }
+            if (fanOut->merged.size() >= fanOut->count) break;
+            if (addToFanOut(*fanOut, content)) {
+                leg.latency.questions++;
             } else {
-                // Fallback to local current affairs questions
-                emit questionsFetched(getLocalCurrentAffairsQuestions(count));
+                leg.latency.duplicates++;
+            }
+        }
+        if (leg.stream->isFinished()) {
+            leg.done = true;
+            leg.latency.completeMs = elapsed;
+            leg.latency.failed = leg.stream->pushedCount() == 0;
+        }
+        allDone = allDone && leg.done;
+    }
+    
+    // No need to wait for the deadline once there is nothing left to wait for
+    if (allDone || fanOut->merged.size() >= fanOut->count) {
+        finishFanOut(id);
+    }
+}
+
+void ApiManager::finishFanOut(int id)
+{
+    QSharedPointer<FanOut> fanOut = m_fanOuts.take(id);
+    if (!fanOut) return;
+    
+    // Providers still out finish in the background, for the caches, but
+    // nobody waits on them
+    FanOutReport report;
+    for (FanOut::Leg& leg : fanOut->legs) {
+        if (!leg.done) {
+            disconnect(leg.stream.data(), nullptr, this, nullptr);
+            releaseRequest(leg.request, false);
+        }
+        report.providers.append(leg.latency);
+    }
+    report.fromProviders = fanOut->merged.size();
+    
+    // The rest comes from the local bank
+    if (fanOut->merged.size() < fanOut->count) {
+        const QList<QuizQuestion> local = getLocalCurrentAffairsQuestions(fanOut->count);
+        for (const QuizQuestion& question : local) {
+            addToFanOut(*fanOut, question.content());
+        }
+    }
+    report.fromLocal = fanOut->merged.size() - report.fromProviders;
+    report.totalMs = fanOut->clock.elapsed();
+    m_lastFanOut = report;
+    
+    if (fanOut->out) {
+        fanOut->out->close();
+    } else {
+        emit questionsFetched(fanOut->merged);
+    }
+}
+
+QStringList ApiManager::availableProviders() const
+{
+    return m_sourceOrder;
+}
+
+void ApiManager::setProviders(const QStringList& names)
+{
+    m_providers.clear();
+    for (const QString& name : names) {
+        if (m_sources.contains(name) && !m_providers.contains(name)) {
+            m_providers.append(name);
+        }
+    }
+}
+
+QStringList ApiManager::providers() const
+{
+    return m_providers;
+}
+
+void ApiManager::registerSource(QSharedPointer<QuestionSource> source)
+{
+    if (!source || source->name().isEmpty()) return;
+    QString name = source->name();
+    if (!m_sources.contains(name)) {
+        m_sourceOrder.append(name);
+        m_providers.append(name);
+    }
+    m_sources.insert(name, source);
+}
+
+int ApiManager::loadSourcePlugins(const QString& dir)
+{
+    int loaded = 0;
+    QDir pluginDir(dir);
+    for (const QString& fileName : pluginDir.entryList(QDir::Files)) {
+        if (!QLibrary::isLibrary(fileName)) continue;
+        QPluginLoader loader(pluginDir.absoluteFilePath(fileName));
+        QObject* instance = loader.instance();
+        QuestionSource* source = qobject_cast<QuestionSource*>(instance);
+        if (!source) {
+            if (instance) loader.unload();
+            else qDebug() << "Question source plugin not loaded:" << loader.errorString();
+            continue;
+        }
+        // The loader owns the instance and keeps it until the application
+        // exits, so the pointer must not delete it
+        registerSource(QSharedPointer<QuestionSource>(source, [](QuestionSource*) {}));
+        loaded++;
+    }
+    return loaded;
+}
+
+bool ApiManager::configureProvider(const QString& name, const QVariantMap& settings)
+{
+    QSharedPointer<QuestionSource> source = m_sources.value(name);
+    if (!source) return false;
+    source->configure(settings);
+    return true;
+}
+
+bool ApiManager::providerQuery(const QString& name, int count, ProviderQuery& query) const
+{
+    // Elements are parsed on the parse pool as the body arrives, each
+    // turned into a question at once; no document is built. Once count
+    // questions are in, the rest of the body is dropped unparsed. Sets are
+    // cached by provider and query, with any key left out.
+    QSharedPointer<QuestionSource> source = m_sources.value(name);
+    if (!source) return false;
+    query.count = count;
+    query.url = source->requestUrl(count);
+    if (query.url.isEmpty()) return false;
+    query.setKey = name + "/" + source->cacheKey(count);
+    query.arrayKey = source->arrayKey();
+    // The parse pool holds the source for as long as a parse runs, even if
+    // it is replaced meanwhile
+    query.converter = [source](const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) {
+        return source->toQuestion(element, rng, question);
+    };
+    query.statusKey = source->statusKey();
+    query.okStatus = source->okStatus();
+    return true;
+}
+
+int ApiManager::fetchProvider(ProviderQuery query, QSharedPointer<QuestionStream> stream)
+{
+    QList<QuizQuestion> cached;
+    qint64 ageSecs = 0;
+    if (!loadCachedSet(query.setKey, cached, ageSecs)) {
+        if (!m_cacheDir.isEmpty()) m_requestStats.setMisses++;
+        return sendRequest(query, true, stream);
+    }
+    
+    if (ageSecs < QuestionSetFreshSecs) {
+        m_requestStats.setHits++;
+        return deliverCached(cached, stream);
+    }
+    if (ageSecs < QuestionSetStaleSecs) {
+        // Stale while revalidate: the quiz starts on the cached set, and
+        // the next one gets whatever the refresh brings
+        m_requestStats.staleHits++;
+        sendRequest(query, false, QSharedPointer<QuestionStream>());
+        return deliverCached(cached, stream);
+    }
+    
+    // Too old to start on, but better than the local set if the fetch fails
+    m_requestStats.setMisses++;
+    query.fallback = [cached]() { return cached; };
+    query.staleFallback = true;
+    return sendRequest(query, true, stream);
+}
+
+int ApiManager::deliverCached(const QList<QuizQuestion>& questions, QSharedPointer<QuestionStream> stream,
+                              bool fellBack)
+{
+    int id = m_nextRequestId++;
+    m_requestStats.requests++;
+    if (stream) {
+        for (const QuizQuestion& question : questions) {
+            stream->push(question);
+        }
+        stream->close(fellBack);
+        return id;
+    }
+    
+    // Emitted from the event loop, like a fetched result, unless cancelled
+    // before then
+    m_cachedDeliveries.insert(id);
+    QMetaObject::invokeMethod(this, [this, id, questions]() {
+        if (!m_cachedDeliveries.remove(id)) return;
+        emit questionsFetched(questions);
+    }, Qt::QueuedConnection);
+    return id;
+}
+
+int ApiManager::sendRequest(const ProviderQuery& query, bool wait, QSharedPointer<QuestionStream> stream)
+{
+    int id = 0;
+    if (wait) {
+        id = m_nextRequestId++;
+        m_requestStats.requests++;
+    }
+    
+    // The same request in flight already: wait on its transfer. The count
+    // is part of it, since a transfer stops parsing once it has enough.
+    QString key = query.url.toString() + "#" + QString::number(query.count);
+    PendingRequestPtr existing = m_inFlight.value(key);
+    if (existing) {
+        if (wait) {
+            m_requestStats.coalesced++;
+            joinRequest(existing, id, stream);
+        }
+        return id;
+    }
+    
+    QNetworkRequest networkRequest(query.url);
+    networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    
+    PendingRequestPtr request = PendingRequestPtr::create();
+    request->key = key;
+    request->query = query;
+    
+    // The handler runs on the pool. The request outlives the parse: the
+    // parse's completion holds it.
+    PendingRequest* pending = request.data();
+    int count = query.count;
+    request->parser = QSharedPointer<ResponseParser>::create(&m_parsePool, query.arrayKey, query.converter,
+        [pending, count](const QuizQuestion& question, int received) {
+            if (pending->abandoned.load(std::memory_order_relaxed)) return false;
+            if (count > 0) {
+                QMutexLocker locker(&pending->mutex);
+                pending->pushed.append(question);
+                for (const QSharedPointer<QuestionStream>& waiting : pending->streams) {
+                    waiting->push(question);
+                }
             }
+            return count <= 0 || received < count;
+        });
+    
+    m_requestStats.transfers++;
+    if (!wait) m_requestStats.refreshes++;
+    QNetworkReply* reply = m_networkManager->get(networkRequest);
+    request->reply = reply;
+    m_inFlight.insert(key, request);
+    if (wait) {
+        joinRequest(request, id, stream);
+    }
+    updateLoadingState();
+    
+    connect(reply, &QNetworkReply::readyRead, this, [reply, request]() {
+        QElapsedTimer blocked;
+        blocked.start();
+        QByteArray chunk = reply->readAll();
+        request->bytes += chunk.size();
+        request->parser->feed(chunk);
+        request->parser->addCallerTime(blocked.nsecsElapsed());
+    });
+    connect(reply, &QNetworkReply::finished, this, [this, reply, request]() {
+        QElapsedTimer blocked;
+        blocked.start();
+        bool received = reply->error() == QNetworkReply::NoError;
+        if (received) {
+            QByteArray rest = reply->readAll();
+            request->bytes += rest.size();
+            request->parser->feed(rest);
+            request->fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
         } else {
-            // Fallback to local current affairs questions
-            emit questionsFetched(getLocalCurrentAffairsQuestions(count));
+            request->error = reply->errorString();
         }
-        
+        request->reply = nullptr;
         reply->deleteLater();
+        
+        // The result comes back to this thread once the pool is through
+        request->parser->finish(this, [this, request, received]() {
+            completeRequest(request, received);
+        });
+        request->parser->addCallerTime(blocked.nsecsElapsed());
     });
+    
+    // A deadline per transfer, gone with its reply
+    QTimer::singleShot(RequestTimeoutMs, reply, [this, reply, request]() {
+        if (reply->isFinished()) return;
+        request->timedOut = true;
+        m_requestStats.timedOut++;
+        reply->abort();
+    });
+    return id;
 }
 
-void ApiManager::fetchCustomQuestions()
+void ApiManager::joinRequest(const PendingRequestPtr& request, int id, QSharedPointer<QuestionStream> stream)
 {
-    // Fetch programming questions from GeeksforGeeks API
-    QString url = "https://api.geeksforgeeks.org/problems/get-problems?category=all&difficulty=all&type=all";
+    request->waiters.append({id, stream});
+    if (!stream) return;
     
-    QNetworkRequest request((QUrl(url)));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    // A late stream first gets what the others have had
+    QMutexLocker locker(&request->mutex);
+    for (const QuizQuestion& question : request->pushed) {
+        stream->push(question);
+    }
+    request->streams.append(stream);
+}
+
+void ApiManager::cancelRequest(int id)
+{
+    if (m_cachedDeliveries.remove(id)) {
+        m_requestStats.cancelled++;
+        return;
+    }
     
-    m_isLoading = true;
-    emit loadingStateChanged(true);
-    m_timeoutTimer->start(10000); // 10 second timeout
+    QSharedPointer<FanOut> fanOut = m_fanOuts.take(id);
+    if (fanOut) {
+        m_requestStats.cancelled++;
+        for (const FanOut::Leg& leg : fanOut->legs) {
+            if (!leg.done) releaseRequest(leg.request, true);
+        }
+        return;
+    }
     
-    QNetworkReply* reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-            QJsonObject response = doc.object();
+    if (releaseRequest(id, true)) {
+        m_requestStats.cancelled++;
+    }
+}
+
+bool ApiManager::releaseRequest(int id, bool abortUnused)
+{
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ++it) {
+        PendingRequestPtr request = it.value();
+        for (int i = 0; i < request->waiters.size(); ++i) {
+            if (request->waiters[i].id != id) continue;
             
-            if (response["status"].toString() == "SUCCESS") {
-                QJsonArray problems = response["results"].toArray();
-                QList<QuizQuestion> quizQuestions;
-                
-                for (const QJsonValue& value : problems) {
-                    QJsonObject problem = value.toObject();
-                    QString title = problem["title"].toString();
-                    QString difficultyStr = problem["difficulty"].toString();
-                    
-                    if (!title.isEmpty()) {
-                        // Create question from problem title
-                        QString question = QString("What is the main concept tested in: %1?").arg(title);
-                        
-                        // Create options based on common DSA concepts
-                        QStringList options;
-                        options.append("Data Structures");
-                        options.append("Algorithms");
-                        options.append("Dynamic Programming");
-                        options.append("Graph Theory");
-                        
-                        // Shuffle options
-                        std::mt19937 rng(QRandomGenerator::global()->generate());
-                        std::shuffle(options.begin(), options.end(), rng);
-                        
-                        // Determine difficulty
-                        Difficulty difficulty = Difficulty::Easy;
-                        if (difficultyStr == "Hard") {
-                            difficulty = Difficulty::Hard;
-                        } else if (difficultyStr == "Medium") {
-                            difficulty = Difficulty::Medium;
-                        }
-                        
-                        QuizQuestion quizQuestion(question, options, "Data Structures", difficulty);
-                        quizQuestions.append(quizQuestion);
-                    }
+            QSharedPointer<QuestionStream> stream = request->waiters.takeAt(i).stream;
+            if (stream) {
+                QMutexLocker locker(&request->mutex);
+                request->streams.removeOne(stream);
+            }
+            if (request->waiters.isEmpty() && abortUnused) {
+                // Nobody left: stop the transfer and the parse. An identical
+                // request from now on starts a transfer of its own.
+                m_inFlight.erase(it);
+                m_requestStats.abandoned++;
+                request->abandoned.store(true, std::memory_order_relaxed);
+                if (request->reply) {
+                    request->reply->abort();
                 }
-                
-                emit questionsFetched(quizQuestions);
-            } else {
-                // Fallback to local C++/DSA questions
-                emit questionsFetched(getCppDSAQuestions());
+                updateLoadingState();
             }
-        } else {
-            // Fallback to local C++/DSA questions
-            emit questionsFetched(getCppDSAQuestions());
+            return true;
         }
-        
-        reply->deleteLater();
-    });
+    }
+    return false;
+}
+
+void ApiManager::cancelAllRequests()
+{
+    QList<int> ids = m_cachedDeliveries.values() + m_fanOuts.keys();
+    const QList<PendingRequestPtr> requests = m_inFlight.values();
+    for (const PendingRequestPtr& request : requests) {
+        for (const PendingRequest::Waiter& waiter : request->waiters) {
+            ids.append(waiter.id);
+        }
+    }
+    for (int id : ids) {
+        cancelRequest(id);
+    }
+}
+
+bool ApiManager::isLoading() const
+{
+    return m_isLoading;
+}
+
+void ApiManager::completeRequest(const PendingRequestPtr& request, bool received)
+{
+    QElapsedTimer blocked;
+    blocked.start();
+    if (m_inFlight.value(request->key) == request) {
+        m_inFlight.remove(request->key);
+    }
+    updateLoadingState();
+    if (request->abandoned.load(std::memory_order_relaxed)) return;
+    
+    const ProviderQuery& query = request->query;
+    const ResponseParser& parser = *request->parser;
+    const QList<QuizQuestion>& questions = parser.questions();
+    bool fetched = received && parser.isComplete()
+        && parser.fields().value(query.statusKey) == query.okStatus;
+    
+    // Kept for the next start. An answer from the HTTP cache means the
+    // provider had nothing new; the set is stored again all the same,
+    // which resets its age.
+    if (fetched) {
+        if (request->fromCache) m_requestStats.notModified++;
+        storeCachedSet(query.setKey, questions);
+    }
+    
+    // A background refresh has nobody to tell
+    if (request->waiters.isEmpty()) {
+        recordFetch(parser, blocked.nsecsElapsed());
+        return;
+    }
+    
+    // Every coalesced call was spared this many bytes and a parse of them
+    m_requestStats.bytesShared += request->bytes * (request->waiters.size() - 1);
+    
+    // A failed transfer falls back on a cached set, however old, before
+    // it is reported as an error
+    bool failed = !received && !query.staleFallback;
+    bool wantsList = false;
+    QList<QuizQuestion> local;
+    for (const PendingRequest::Waiter& waiter : request->waiters) {
+        if (!waiter.stream) {
+            wantsList = true;
+            continue;
+        }
+        // A streamed quiz may already be running on what arrived, so a
+        // short fetch is topped up rather than replaced
+        if (!fetched) {
+            if (local.isEmpty()) local = query.fallback();
+            for (int i = questions.size(); i < query.count && i < local.size(); ++i) {
+                waiter.stream->push(local[i]);
+            }
+        }
+        waiter.stream->close(!fetched);
+    }
+    
+    if (!failed && wantsList && !fetched && local.isEmpty()) {
+        // Fallback to local questions
+        local = query.fallback();
+    }
+    recordFetch(parser, blocked.nsecsElapsed());
+    
+    // Reported once, however many calls waited on it
+    if (failed) {
+        QString error = request->timedOut ? QString("Request timed out") : request->error;
+        for (const PendingRequest::Waiter& waiter : request->waiters) {
+            emit requestFailed(waiter.id, error);
+        }
+    }
+    if (failed && request->timedOut) {
+        emit errorOccurred("Request timed out");
+    } else if (failed) {
+        handleApiError(request->error);
+    } else if (wantsList) {
+        emit questionsFetched(fetched ? questions : local);
+    }
+}
+
+void ApiManager::updateLoadingState()
+{
+    bool loading = !m_inFlight.isEmpty();
+    if (loading == m_isLoading) return;
+    m_isLoading = loading;
+    emit loadingStateChanged(loading);
+}
+
+void ApiManager::setApiEndpoint(const QString& url, const QString& key)
+{
+    configureProvider("newsapi", {{"url", url}, {"key", key}});
+}
+
+void ApiManager::setCacheDirectory(const QString& path)
+{
+    m_cacheDir = path;
+    if (path.isEmpty()) {
+        m_networkManager->setCache(nullptr); // deletes the old one
+        return;
+    }
+    
+    // QNetworkAccessManager revalidates a stale entry with If-None-Match
+    // or If-Modified-Since and serves it on 304 Not Modified
+    QNetworkDiskCache* cache = new QNetworkDiskCache(m_networkManager);
+    cache->setCacheDirectory(QDir(path).filePath("http"));
+    cache->setMaximumCacheSize(HttpCacheBytes);
+    m_networkManager->setCache(cache);
+}
+
+QString ApiManager::cacheDirectory() const
+{
+    return m_cacheDir;
+}
+
+QString ApiManager::cachedSetPath(const QString& key) const
+{
+    QByteArray name = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QDir(m_cacheDir).filePath("questionsets/" + QString::fromLatin1(name) + ".qpk");
+}
+
+bool ApiManager::loadCachedSet(const QString& key, QList<QuizQuestion>& questions, qint64& ageSecs) const
+{
+    if (m_cacheDir.isEmpty()) return false;
+    QString path = cachedSetPath(key);
+    
+    // A set stored moments ago may still be queued for writing
+    QuestionPack pack;
+    QByteArray pending;
+    if (m_persistence && m_persistence->pendingContents(path, pending)) {
+        if (!pack.load(pending)) return false;
+        ageSecs = 0;
+    } else {
+        QFileInfo info(path);
+        if (!info.exists() || !pack.open(path)) return false;
+        ageSecs = info.lastModified().secsTo(QDateTime::currentDateTime());
+    }
+    questions = pack.questions();
+    return pack.isValid() && !questions.isEmpty();
+}
+
+void ApiManager::storeCachedSet(const QString& key, const QList<QuizQuestion>& questions)
+{
+    if (m_cacheDir.isEmpty() || questions.isEmpty()) return;
+    QString path = cachedSetPath(key);
+    QDir().mkpath(QFileInfo(path).path());
+    
+    // Stored as a pack, which opens without parsing, and written behind
+    // like custom quizzes
+    auto writer = [questions](QIODevice& device) {
+        return QuestionPack::write(device, questions);
+    };
+    if (m_persistence) {
+        m_persistence->replaceFile(path, writer);
+        return;
+    }
+    
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        if (!writer(file)) {
+            file.cancelWriting();
+        }
+        file.commit();
+    }
 }
 
 QList<QuizQuestion> ApiManager::getDefaultQuestions()
 {
-    return m_defaultQuestions;
+    return QuestionBank::instance().snapshot("default")->questions();
 }
 
 QList<QuizQuestion> ApiManager::getCppDSAQuestions()
 {
-    return m_cppDSAQuestions;
+    return QuestionBank::instance().snapshot("cpp_dsa")->questions();
 }
 
 QList<QuizQuestion> ApiManager::getQuestionsByDifficulty(Difficulty difficulty)
 {
-    return selectQuestionsByDifficulty(m_cppDSAQuestions, difficulty, 10);
+    return selectQuestionsByDifficulty(getCppDSAQuestions(), difficulty, 10);
 }
 
 void ApiManager::saveCustomQuiz(const QString& name, const QList<QuizQuestion>& questions)
 {
-    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir dir(dataPath);
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
+    // Published first: the next quiz on it uses the new version, while
+    // quizzes already running keep the one they started with
+    QuestionBank::instance().publish(QuestionBank::customName(name), questions);
+    
+    QuizFileFormat format = m_customQuizFormat;
+    QString filePath = customQuizPath(name, format);
+    QDir().mkpath(QFileInfo(filePath).path());
     
-    QString filePath = dir.filePath(name + ".json");
-    QFile file(filePath);
+    // Serializing and writing happen off the GUI thread when possible
+    auto writer = [name, questions, format](QIODevice& device) {
+        return writeQuizFile(device, name, questions, format);
+    };
+    if (m_persistence) {
+        m_persistence->replaceFile(filePath, writer);
+        return;
+    }
     
+    QSaveFile file(filePath);
     if (file.open(QIODevice::WriteOnly)) {
-        QJsonArray questionsArray;
-        for (const QuizQuestion& question : questions) {
-            questionsArray.append(question.toJson());
+        if (!writer(file)) {
+            file.cancelWriting();
         }
-        
-        QJsonObject quizObject;
-        quizObject["name"] = name;
-        quizObject["questions"] = questionsArray;
-        
-        QJsonDocument doc(quizObject);
-        file.write(doc.toJson());
-        file.close();
+        file.commit();
     }
 }
 
 QList<QuizQuestion> ApiManager::loadCustomQuiz(const QString& name)
 {
-    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QString filePath = QDir(dataPath).filePath(name + ".json");
-    QFile file(filePath);
-    
-    QList<QuizQuestion> questions;
-    if (file.open(QIODevice::ReadOnly)) {
-        QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-        QJsonObject quizObject = doc.object();
-        QJsonArray questionsArray = quizObject["questions"].toArray();
-        
-        for (const QJsonValue& value : questionsArray) {
-            questions.append(QuizQuestion::fromJson(value.toObject()));
+    // A quiz saved moments ago may still be queued for writing
+    QByteArray pending;
+    for (QuizFileFormat format : {QuizFileFormat::Pack, QuizFileFormat::Cbor, QuizFileFormat::Json}) {
+        if (m_persistence && m_persistence->pendingContents(customQuizPath(name, format), pending)) {
+            QBuffer buffer(&pending);
+            buffer.open(QIODevice::ReadOnly);
+            return readQuizFile(buffer);
         }
-        file.close();
     }
     
-    return questions;
+    // Otherwise the format saved last, whatever the file turns out to hold
+    QFile file(newestCustomQuizPath(name));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QList<QuizQuestion>();
+    }
+    return readQuizFile(file);
 }
 
-QStringList ApiManager::getAvailableCustomQuizzes()
+QSharedPointer<const QuestionPack> ApiManager::openCustomPack(const QString& name)
 {
-    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir dir(dataPath);
-    QStringList quizzes;
+    QString packPath = customQuizPath(name, QuizFileFormat::Pack);
+    QByteArray pending;
+    if (m_persistence && m_persistence->pendingContents(packPath, pending)) {
+        return QSharedPointer<const QuestionPack>();
+    }
+    if (newestCustomQuizPath(name) != packPath) {
+        return QSharedPointer<const QuestionPack>();
+    }
     
-    if (dir.exists()) {
-        QStringList filters;
-        filters << "*.json";
-        QStringList files = dir.entryList(filters, QDir::Files);
-        
-        for (const QString& file : files) {
-            QString name = file;
-            name.remove(".json");
-            quizzes.append(name);
+    QSharedPointer<QuestionPack> pack = QSharedPointer<QuestionPack>::create();
+    if (!pack->open(packPath)) {
+        qDebug() << "Cannot open question pack" << packPath;
+        return QSharedPointer<const QuestionPack>();
+    }
+    return pack;
+}
+
+ApiManager::FetchStats ApiManager::fetchStats() const
+{
+    return m_fetchStats;
+}
+
+ApiManager::RequestStats ApiManager::requestStats() const
+{
+    return m_requestStats;
+}
+
+void ApiManager::recordFetch(const ResponseParser& parser, qint64 finishNs)
+{
+    // Blocked time is everything this thread spent on the fetch: copying
+    // chunks to the pool, and handling the result
+    double blockedMs = parser.callerMs() + finishNs / 1e6;
+    m_fetchStats.fetches++;
+    m_fetchStats.lastBlockedMs = blockedMs;
+    m_fetchStats.averageBlockedMs += (blockedMs - m_fetchStats.averageBlockedMs) / m_fetchStats.fetches;
+    m_fetchStats.maxBlockedMs = qMax(m_fetchStats.maxBlockedMs, blockedMs);
+    m_fetchStats.lastParseMs = parser.parseMs();
+    m_fetchStats.lastQuestions = parser.questions().size();
+}
+
+void ApiManager::setPersistenceService(PersistenceService* service)
+{
+    m_persistence = service;
+}
+
+void ApiManager::setCustomQuizFormat(QuizFileFormat format)
+{
+    m_customQuizFormat = format;
+}
+
+QuizFileFormat ApiManager::customQuizFormat() const
+{
+    return m_customQuizFormat;
+}
+
+bool ApiManager::writeQuizFile(QIODevice& device, const QString& name,
+                               const QList<QuizQuestion>& questions, QuizFileFormat format)
+{
+    if (format == QuizFileFormat::Pack) {
+        // A pack has no name of its own; it is the file name
+        return QuestionPack::write(device, questions);
+    }
+    
+    if (format == QuizFileFormat::Json) {
+        QJsonArray questionsArray;
+        for (const QuizQuestion& question : questions) {
+            questionsArray.append(question.toJson());
         }
+        
+        QJsonObject quizObject;
+        quizObject["name"] = name;
+        quizObject["questions"] = questionsArray;
+        QByteArray bytes = QJsonDocument(quizObject).toJson();
+        return device.write(bytes) == bytes.size();
     }
     
-    return quizzes;
+    // Streamed straight to the device, one question at a time. The
+    // self-describe tag up front is how a load tells the formats apart.
+    QCborStreamWriter writer(&device);
+    writer.append(QCborKnownTags::Signature);
+    writer.startMap(2);
+    writer.append(QLatin1String("name"));
+    writer.append(name);
+    writer.append(QLatin1String("questions"));
+    writer.startArray(questions.size());
+    for (const QuizQuestion& question : questions) {
+        question.toCbor(writer);
+    }
+    writer.endArray();
+    writer.endMap();
+    
+    // The writer reports nothing itself; a failed write shows on the file
+    if (QFileDevice* file = qobject_cast<QFileDevice*>(&device)) {
+        return file->error() == QFileDevice::NoError;
+    }
+    return device.isWritable();
 }
 
-void ApiManager::onNetworkReplyFinished()
+QList<QuizQuestion> ApiManager::readQuizFile(QIODevice& device)
 {
-    m_timeoutTimer->stop();
-    m_isLoading = false;
-    emit loadingStateChanged(false);
+    QList<QuizQuestion> questions;
     
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
+    if (QuestionPack::isPack(device.peek(4))) {
+        QuestionPack pack;
+        if (pack.load(device.readAll())) {
+            questions = pack.questions();
+        }
+        return questions;
+    }
+    
+    if (device.peek(3) != QByteArray("\xd9\xd9\xf7", 3)) {
+        // Read in chunks; only one question's JSON is held at a time
+        JsonArrayStream stream("questions", [&questions](const QJsonObject& object) {
+            questions.append(QuizQuestion::fromJson(object));
+            return true;
+        });
+        if (!stream.readAll(device)) {
+            qDebug() << "Custom quiz file is damaged:" << stream.errorString();
+        }
+        return questions;
+    }
     
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray data = reply->readAll();
-        QJsonDocument doc = QJsonDocument::fromJson(data);
+    QCborStreamReader reader(&device);
+    if (reader.isTag() && reader.toTag() == QCborKnownTags::Signature) {
+        reader.next();
+    }
+    if (!reader.isMap() || !reader.enterContainer()) {
+        return questions;
+    }
+    
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        if (!reader.isString()) {
+            reader.next();
+            reader.next();
+            continue;
+        }
         
-        QList<QuizQuestion> questions = parseApiResponse(doc);
-        emit questionsFetched(questions);
-    } else {
-        handleApiError(reply->errorString());
+        auto key = reader.readString();
+        QString name;
+        while (key.status == QCborStreamReader::Ok) {
+            name += key.data;
+            key = reader.readString();
+        }
+        if (name != QLatin1String("questions") || !reader.isArray()) {
+            reader.next();
+            continue;
+        }
+        
+        if (reader.isLengthKnown()) {
+            questions.reserve(static_cast<qsizetype>(reader.length()));
+        }
+        reader.enterContainer();
+        while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+            QuizQuestion question;
+            if (!QuizQuestion::fromCbor(reader, question)) break;
+            questions.append(question);
+        }
+        reader.leaveContainer();
     }
     
-    reply->deleteLater();
+    if (reader.lastError() != QCborError::NoError) {
+        qDebug() << "Custom quiz file is damaged:" << reader.lastError().toString();
+    }
+    return questions;
 }
 
-void ApiManager::onNetworkTimeout()
+QString ApiManager::customQuizPath(const QString& name, QuizFileFormat format)
 {
-    m_isLoading = false;
-    emit loadingStateChanged(false);
-    emit errorOccurred("Request timed out");
+    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    const char* suffix = format == QuizFileFormat::Pack ? ".qpk"
+                       : format == QuizFileFormat::Cbor ? ".cbor" : ".json";
+    return QDir(dataPath).filePath(name + suffix);
 }
 
-void ApiManager::initializeDefaultQuestions()
+QString ApiManager::newestCustomQuizPath(const QString& name) const
 {
-    // Add some general knowledge questions as default
-    m_defaultQuestions = {
-        QuizQuestion("What is the capital of France?", 
-                    {"London", "Berlin", "Paris", "Madrid"}, 
-                    "Paris", Difficulty::Easy),
-        QuizQuestion("Which planet is closest to the Sun?", 
-                    {"Venus", "Mercury", "Earth", "Mars"}, 
-                    "Mercury", Difficulty::Easy),
-        QuizQuestion("What is 2 + 2?", 
-                    {"3", "4", "5", "6"}, 
-                    "4", Difficulty::Easy)
-    };
-}
-
-void ApiManager::initializeCppDSAQuestions()
-{
-    m_cppDSAQuestions = {
-        // Easy C++/DSA Questions
-        QuizQuestion("What is the time complexity of accessing an element in an array?", 
-                    {"O(1)", "O(n)", "O(log n)", "O(n²)"}, 
-                    "O(1)", Difficulty::Easy),
-        QuizQuestion("Which data structure follows LIFO principle?", 
-                    {"Queue", "Stack", "Tree", "Graph"}, 
-                    "Stack", Difficulty::Easy),
-        QuizQuestion("What is the default constructor in C++?", 
-                    {"A constructor with no parameters", "A constructor with all default parameters", 
-                     "A constructor that initializes all members to zero", "A constructor that takes a class object as parameter"}, 
-                    "A constructor with no parameters", Difficulty::Easy),
-        
-        // Medium C++/DSA Questions
-        QuizQuestion("What is the time complexity of binary search?", 
-                    {"O(1)", "O(n)", "O(log n)", "O(n²)"}, 
-                    "O(log n)", Difficulty::Medium),
-        QuizQuestion("Which sorting algorithm has the best average-case time complexity?", 
-                    {"Bubble Sort", "Quick Sort", "Selection Sort", "Insertion Sort"}, 
-                    "Quick Sort", Difficulty::Medium),
-        QuizQuestion("What is a virtual function in C++?", 
-                    {"A function that can be overridden in derived classes", "A function that cannot be inherited", 
-                     "A function that is automatically called", "A function that returns void"}, 
-                    "A function that can be overridden in derived classes", Difficulty::Medium),
-        
-        // Hard C++/DSA Questions
-        QuizQuestion("What is the time complexity of merge sort?", 
-                    {"O(n log n)", "O(n²)", "O(n)", "O(log n)"}, 
-                    "O(n log n)", Difficulty::Hard),
-        QuizQuestion("What is a smart pointer in C++?", 
-                    {"A pointer that automatically manages memory", "A pointer that points to smart objects", 
-                     "A pointer that can only point to integers", "A pointer that is always null"}, 
-                    "A pointer that automatically manages memory", Difficulty::Hard),
-        QuizQuestion("What is the space complexity of recursive Fibonacci implementation?", 
-                    {"O(1)", "O(n)", "O(2^n)", "O(log n)"}, 
-                    "O(2^n)", Difficulty::Hard)
-    };
+    // A quiz re-saved in another format leaves the old file behind; the
+    // most recently written one is current
+    QFileInfo newest;
+    for (QuizFileFormat format : {QuizFileFormat::Pack, QuizFileFormat::Cbor, QuizFileFormat::Json}) {
+        QFileInfo candidate(customQuizPath(name, format));
+        if (candidate.exists() && (!newest.exists() || candidate.lastModified() > newest.lastModified())) {
+            newest = candidate;
+        }
+    }
+    return newest.filePath();
 }
 
-QList<QuizQuestion> ApiManager::parseApiResponse(const QJsonDocument& response)
+QStringList ApiManager::getAvailableCustomQuizzes()
 {
-    QList<QuizQuestion> questions;
-    QJsonObject root = response.object();
+    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir dir(dataPath);
+    QStringList quizzes;
     
-    if (root["response_code"].toInt() == 0) {
-        QJsonArray results = root["results"].toArray();
+    if (dir.exists()) {
+        QStringList filters;
+        filters << "*.json" << "*.cbor" << "*.qpk";
+        QStringList files = dir.entryList(filters, QDir::Files);
         
-        for (const QJsonValue& value : results) {
-            QJsonObject questionObj = value.toObject();
-            
-            QString question = questionObj["question"].toString();
-            QString correctAnswer = questionObj["correct_answer"].toString();
-            QString difficultyStr = questionObj["difficulty"].toString();
-            
-            QJsonArray incorrectAnswers = questionObj["incorrect_answers"].toArray();
-            QStringList options;
-            options.append(correctAnswer);
-            
-            for (const QJsonValue& incorrect : incorrectAnswers) {
-                options.append(incorrect.toString());
+        for (const QString& file : files) {
+            QString name = QFileInfo(file).completeBaseName();
+            if (!quizzes.contains(name)) {
+                quizzes.append(name);
             }
-            
-            // Shuffle options
-            std::mt19937 rng(QRandomGenerator::global()->generate());
-            std::shuffle(options.begin(), options.end(), rng);
-            
-            Difficulty difficulty = QuizQuestion::stringToDifficulty(difficultyStr);
-            QuizQuestion q(question, options, correctAnswer, difficulty);
-            questions.append(q);
         }
     }
     
-    return questions;
+    return quizzes;
 }
 
 void ApiManager::handleApiError(const QString& error)
@@ -418,38 +1057,7 @@ QList<QuizQuestion> ApiManager::shuffleQuestions(const QList<QuizQuestion>& ques
 
 QList<QuizQuestion> ApiManager::getLocalCurrentAffairsQuestions(int count)
 {
-    QList<QuizQuestion> currentAffairsQuestions = {
-        QuizQuestion("Which country recently hosted the G20 summit?", 
-                    {"India", "Brazil", "Indonesia", "Italy"}, 
-                    "India", Difficulty::Easy),
-        QuizQuestion("What is the main focus of COP28 climate conference?", 
-                    {"Renewable Energy", "Carbon Reduction", "Climate Finance", "All of the above"}, 
-                    "All of the above", Difficulty::Medium),
-        QuizQuestion("Which technology company recently launched AI-powered search?", 
-                    {"Google", "Microsoft", "OpenAI", "Meta"}, 
-                    "Google", Difficulty::Easy),
-        QuizQuestion("What is the primary goal of the Paris Agreement?", 
-                    {"Limit global temperature rise", "Reduce fossil fuel use", "Increase renewable energy", "All of the above"}, 
-                    "All of the above", Difficulty::Medium),
-        QuizQuestion("Which country recently joined NATO?", 
-                    {"Ukraine", "Finland", "Sweden", "Both Finland and Sweden"}, 
-                    "Both Finland and Sweden", Difficulty::Medium),
-        QuizQuestion("What is the main challenge in global supply chains?", 
-                    {"Labor shortages", "Climate change", "Geopolitical tensions", "All of the above"}, 
-                    "All of the above", Difficulty::Hard),
-        QuizQuestion("Which sector is leading in AI adoption?", 
-                    {"Healthcare", "Finance", "Technology", "Manufacturing"}, 
-                    "Technology", Difficulty::Easy),
-        QuizQuestion("What is the primary concern about social media platforms?", 
-                    {"Privacy", "Misinformation", "Addiction", "All of the above"}, 
-                    "All of the above", Difficulty::Medium),
-        QuizQuestion("Which renewable energy source is growing fastest?", 
-                    {"Solar", "Wind", "Hydroelectric", "Geothermal"}, 
-                    "Solar", Difficulty::Easy),
-        QuizQuestion("What is the main focus of digital transformation?", 
-                    {"Automation", "Customer experience", "Data analytics", "All of the above"}, 
-                    "All of the above", Difficulty::Hard)
-    };
+    QList<QuizQuestion> currentAffairsQuestions = QuestionBank::instance().snapshot("current_affairs")->questions();
     
     // Shuffle and return requested count
     currentAffairsQuestions = shuffleQuestions(currentAffairsQuestions);
@@ -8,19 +8,142 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QTimer>
+#include <QSharedPointer>
+#include <QHash>
+#include <QSet>
+#include <QUrl>
+#include <QThreadPool>
+#include <functional>
+#include <random>
 #include "quizquestion.h"
+#include "questionstream.h"
+#include "responseparser.h"
+#include "questionsource.h"
+
+class PersistenceService;
+class QNetworkDiskCache;
+class QuestionPack;
+class QIODevice;
+
+// On-disk format of a custom quiz. Loading detects the format from the
+// file contents, so any of them can be read whatever it was saved as.
+enum class QuizFileFormat {
+    Json, // <name>.json, indented JSON
+    Cbor, // <name>.cbor, streamed CBOR with integer keys
+    Pack  // <name>.qpk, indexed question pack, mapped rather than parsed
+};
 
 class ApiManager : public QObject
 {
     Q_OBJECT
 
 public:
+    // Cost of fetches to the GUI thread. Parsing runs on a pool; what is
+    // left here is copying chunks over and handling the result.
+    struct FetchStats {
+        qint64 fetches = 0;
+        double lastBlockedMs = 0.0; // GUI thread time, last fetch
+        double averageBlockedMs = 0.0;
+        double maxBlockedMs = 0.0;
+        double lastParseMs = 0.0;   // pool time parsing the last fetch
+        int lastQuestions = 0;
+    };
+    
+    // What the request pipeline did. Coalesced calls were served by a
+    // transfer already in flight instead of a download and parse of
+    // their own.
+    struct RequestStats {
+        qint64 requests = 0;    // fetch calls
+        qint64 transfers = 0;   // network requests actually sent
+        qint64 coalesced = 0;   // calls that joined a transfer in flight
+        qint64 bytesShared = 0; // body bytes coalesced calls did not fetch again
+        qint64 cancelled = 0;   // calls cancelled before their result
+        qint64 abandoned = 0;   // transfers aborted with no caller left
+        qint64 timedOut = 0;    // transfers past their deadline
+        
+        // Caches. A question set younger than the fresh age is served with
+        // no request at all; one younger than the stale age is served at
+        // once and refreshed behind the quiz.
+        qint64 setHits = 0;     // served fresh from the question set cache
+        qint64 staleHits = 0;   // served stale, refreshed in the background
+        qint64 setMisses = 0;   // nothing usable cached, fetched
+        qint64 refreshes = 0;   // background refreshes sent
+        qint64 notModified = 0; // transfers answered from the HTTP cache
+    };
+
+    // How one provider did in a fan-out, in milliseconds from its start
+    struct ProviderLatency {
+        QString provider;
+        qint64 firstQuestionMs = -1; // -1: none arrived in time
+        qint64 completeMs = -1;      // -1: not done by the deadline
+        int questions = 0;           // taken into the merged set
+        int duplicates = 0;          // dropped as already in it
+        bool failed = false;         // done with nothing usable
+    };
+    struct FanOutReport {
+        qint64 totalMs = 0;
+        int fromProviders = 0;
+        int fromLocal = 0;
+        QList<ProviderLatency> providers;
+    };
+
     explicit ApiManager(QObject *parent = nullptr);
-    ~ApiManager();
+    ~ApiManager(); // waits for parses still running
 
     // API Methods
-    void fetchQuestions(int count);
-    void fetchCustomQuestions();
+    // Each returns a request id for cancelRequest(). A call identical to
+    // one still in flight joins its transfer instead of sending another.
+    // Each transfer has a deadline of its own, and its reply is parsed
+    // once and reported once: questionsFetched() with the questions, or a
+    // local fallback if the response was unusable, or errorOccurred() if
+    // the transfer failed or timed out.
+    // With a stream, each question is pushed into it as it is parsed,
+    // topped up with local ones if the fetch falls short, and the stream
+    // is closed; questionsFetched() is not emitted for it
+    int fetchQuestions(int count, QSharedPointer<QuestionStream> stream = QSharedPointer<QuestionStream>());
+    int fetchCustomQuestions();
+    
+    // Fan-out: asks every configured provider at once and merges what
+    // arrives by the deadline, in arrival order, dropping questions whose
+    // text is already in. The remainder comes from the local current
+    // affairs set, so this never fails. With a stream the quiz can start
+    // on the first question from any provider; without one,
+    // questionsFetched() is emitted at the deadline or once every provider
+    // is done, whichever is first. Providers still running then finish in
+    // the background and only feed the caches.
+    static constexpr int DefaultFanOutDeadlineMs = 3000;
+    int fetchFromProviders(int count, QSharedPointer<QuestionStream> stream = QSharedPointer<QuestionStream>(),
+                           int deadlineMs = DefaultFanOutDeadlineMs);
+    FanOutReport lastFanOutReport() const;
+    // Providers the fan-out asks, by name; all of availableProviders() by
+    // default, in the order they were registered
+    QStringList availableProviders() const;
+    void setProviders(const QStringList& names);
+    QStringList providers() const;
+    
+    // Question sources. The built-in ones are registered at construction;
+    // registering a name again replaces that source. Plugins are loaded
+    // from every library in dir that implements QuestionSource; returns
+    // how many were registered.
+    void registerSource(QSharedPointer<QuestionSource> source);
+    int loadSourcePlugins(const QString& dir);
+    // Passes settings to the named source; false if there is none
+    bool configureProvider(const QString& name, const QVariantMap& settings);
+    // The caller hears nothing more of the request. A transfer nobody is
+    // waiting on any more is aborted.
+    void cancelRequest(int id);
+    void cancelAllRequests();
+    bool isLoading() const;
+    
+    // Where NewsAPI requests go and with which key; shorthand for
+    // configureProvider("newsapi", ...)
+    void setApiEndpoint(const QString& url, const QString& key);
+    // Root of the HTTP response cache and the question set cache, under
+    // the user's cache location by default; empty turns both off
+    void setCacheDirectory(const QString& path);
+    QString cacheDirectory() const;
+    FetchStats fetchStats() const;
+    RequestStats requestStats() const;
     
     // Local question management
     QList<QuizQuestion> getDefaultQuestions();
@@ -31,33 +154,90 @@ public:
     void saveCustomQuiz(const QString& name, const QList<QuizQuestion>& questions);
     QList<QuizQuestion> loadCustomQuiz(const QString& name);
     QStringList getAvailableCustomQuizzes();
+    // The quiz as a mapped pack, if that is how it was saved last and the
+    // save is on disk; null otherwise, and loadCustomQuiz() reads it
+    QSharedPointer<const QuestionPack> openCustomPack(const QString& name);
+    
+    // Custom quizzes are written behind through this service when set,
+    // synchronously otherwise
+    void setPersistenceService(PersistenceService* service);
+    
+    // Format new custom quizzes are saved in (JSON by default)
+    void setCustomQuizFormat(QuizFileFormat format);
+    QuizFileFormat customQuizFormat() const;
+    
+    // Quiz file encoding, streamed to and from a device
+    static bool writeQuizFile(QIODevice& device, const QString& name,
+                              const QList<QuizQuestion>& questions, QuizFileFormat format);
+    static QList<QuizQuestion> readQuizFile(QIODevice& device);
 
 signals:
     void questionsFetched(const QList<QuizQuestion>& questions);
     void errorOccurred(const QString& error);
+    // The failed or timed-out transfer behind one request id; emitted
+    // for each caller waiting on it, ahead of errorOccurred()
+    void requestFailed(int requestId, const QString& error);
     void loadingStateChanged(bool loading);
 
-private slots:
-    void onNetworkReplyFinished();
-    void onNetworkTimeout();
-
 private:
+    // One transfer in flight and the calls waiting on it
+    struct PendingRequest;
+    using PendingRequestPtr = QSharedPointer<PendingRequest>;
+    struct FanOut;
+    
+    // A provider request and what to make of its response
+    struct ProviderQuery {
+        QUrl url;
+        QString setKey;   // question set cache key: provider and query
+        QString arrayKey; // array holding the elements
+        ResponseParser::Converter converter;
+        QString statusKey; // root field telling a usable response
+        QJsonValue okStatus; // its value in one
+        int count = 0;    // questions wanted, 0 for all of them
+        std::function<QList<QuizQuestion>()> fallback;
+        bool staleFallback = false; // fallback is a cached set, used on errors too
+    };
+    
     QNetworkAccessManager* m_networkManager;
-    QTimer* m_timeoutTimer;
+    QHash<QString, PendingRequestPtr> m_inFlight; // by URL
+    QSet<int> m_cachedDeliveries; // cached results not yet emitted
+    QString m_cacheDir;
+    QHash<int, QSharedPointer<FanOut>> m_fanOuts; // by request id
+    FanOutReport m_lastFanOut;
+    int m_nextRequestId;
     bool m_isLoading;
+    PersistenceService* m_persistence;
+    QuizFileFormat m_customQuizFormat;
+    QThreadPool m_parsePool;
+    FetchStats m_fetchStats;
+    RequestStats m_requestStats;
     
     // API Configuration
-    QString m_apiUrl;
-    QString m_apiKey;
-    
-    // Local question storage
-    QList<QuizQuestion> m_defaultQuestions;
-    QList<QuizQuestion> m_cppDSAQuestions;
+    QHash<QString, QSharedPointer<QuestionSource>> m_sources; // by name
+    QStringList m_sourceOrder; // names, in registration order
+    QStringList m_providers;
     
     // Helper methods
-    void initializeDefaultQuestions();
-    void initializeCppDSAQuestions();
-    QList<QuizQuestion> parseApiResponse(const QJsonDocument& response);
+    static QString customQuizPath(const QString& name, QuizFileFormat format);
+    QString newestCustomQuizPath(const QString& name) const;
+    bool providerQuery(const QString& name, int count, ProviderQuery& query) const;
+    int fetchProvider(ProviderQuery query, QSharedPointer<QuestionStream> stream);
+    bool releaseRequest(int id, bool abortUnused);
+    bool addToFanOut(FanOut& fanOut, const QuestionContentPtr& content);
+    void onFanOutQuestions(int id);
+    void finishFanOut(int id);
+    // Questions at hand, delivered like a fetch; fellBack for the local set
+    int deliverCached(const QList<QuizQuestion>& questions, QSharedPointer<QuestionStream> stream,
+                      bool fellBack = false);
+    // Returns the request id, or 0 for a background request nobody waits on
+    int sendRequest(const ProviderQuery& query, bool wait, QSharedPointer<QuestionStream> stream);
+    void joinRequest(const PendingRequestPtr& request, int id, QSharedPointer<QuestionStream> stream);
+    void completeRequest(const PendingRequestPtr& request, bool received);
+    void updateLoadingState();
+    QString cachedSetPath(const QString& key) const;
+    bool loadCachedSet(const QString& key, QList<QuizQuestion>& questions, qint64& ageSecs) const;
+    void storeCachedSet(const QString& key, const QList<QuizQuestion>& questions);
+    void recordFetch(const ResponseParser& parser, qint64 finishNs);
     void handleApiError(const QString& error);
     QList<QuizQuestion> getLocalCurrentAffairsQuestions(int count);
     
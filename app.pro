@@ -0,0 +1,94 @@
+QT += core gui widgets network charts
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17
+
+TARGET = QuizSystem
+
+# Headless quiz engine library
+INCLUDEPATH += $$PWD/engine
+DEPENDPATH += $$PWD/engine
+LIBS += -L$$OUT_PWD/engine -lquizengine
+win32-msvc*: PRE_TARGETDEPS += $$OUT_PWD/engine/quizengine.lib
+else: PRE_TARGETDEPS += $$OUT_PWD/engine/libquizengine.a
+
+# Built-in question banks: each questions/<name>.json is compiled into
+# <name>_bank.h, a header of constexpr records, in the build directory
+isEmpty(PYTHON): win32: PYTHON = python
+isEmpty(PYTHON): PYTHON = python3
+BANK_SOURCES = \
+    questions/default.json \
+    questions/cpp_dsa.json \
+    questions/current_affairs.json
+genbank.input = BANK_SOURCES
+genbank.output = ${QMAKE_FILE_BASE}_bank.h
+genbank.commands = $$PYTHON $$shell_path($$PWD/tools/genbank.py) ${QMAKE_FILE_NAME} ${QMAKE_FILE_OUT}
+genbank.depends = $$PWD/tools/genbank.py
+genbank.variable_out = HEADERS
+genbank.CONFIG += no_link target_predeps
+QMAKE_EXTRA_COMPILERS += genbank
+INCLUDEPATH += $$OUT_PWD
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    main.cpp \
+    mainwindow.cpp \
+    quizwindow.cpp \
+    quizmanager.cpp \
+    apimanager.cpp \
+    builtinbanks.cpp \
+    questionbank.cpp \
+    timerwidget.cpp \
+    chartwidget.cpp \
+    customquizmaker.cpp \
+    resultslog.cpp \
+    persistenceservice.cpp \
+    formatbenchmark.cpp \
+    questionpack.cpp \
+    jsonarraystream.cpp \
+    questionstream.cpp \
+    quizprefetcher.cpp \
+    responseparser.cpp \
+    builtinsources.cpp \
+    standinserver.cpp \
+    quizquestion.cpp
+
+HEADERS += \
+    mainwindow.h \
+    quizwindow.h \
+    quizmanager.h \
+    apimanager.h \
+    builtinbanks.h \
+    questionbank.h \
+    timerwidget.h \
+    chartwidget.h \
+    customquizmaker.h \
+    resultslog.h \
+    persistenceservice.h \
+    formatbenchmark.h \
+    questionpack.h \
+    jsonarraystream.h \
+    questionstream.h \
+    quizprefetcher.h \
+    responseparser.h \
+    questionsource.h \
+    builtinsources.h \
+    standinserver.h \
+    quizquestion.h
+
+# FORMS removed - UI created programmatically
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+# macOS specific
+macx {
+    ICON = app_icon.icns
+    QMAKE_INFO_PLIST = Info.plist
+} 
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "builtinbanks.h"
+#include "default_bank.h"
+#include "cpp_dsa_bank.h"
+#include "current_affairs_bank.h"
+
+namespace {
+
+QString rawString(QStringView text)
+{
+    // Points at the literal; it is never freed, so nothing is copied
+    return QString::fromRawData(text.data(), text.size());
+}
+
+QList<QuestionContentPtr> buildContents(const BuiltinBank& bank)
+{
+    QList<QuestionContentPtr> contents;
+    contents.reserve(bank.count);
+    for (const BuiltinQuestion* record = bank.questions; record != bank.questions + bank.count; ++record) {
+        QSharedPointer<QuestionContent> content = QSharedPointer<QuestionContent>::create();
+        content->question = rawString(record->question);
+        content->options.reserve(record->optionCount);
+        for (int i = 0; i < record->optionCount; ++i) {
+            content->options.append(rawString(record->options[i]));
+        }
+        content->correctAnswer = content->options[record->correctIndex];
+        content->correctIndex = record->correctIndex;
+        content->difficulty = record->difficulty;
+        content->type = record->type;
+        contents.append(content);
+    }
+    return contents;
+}
+
+}
+
+const BuiltinBank& builtinBank(BuiltinBankId id)
+{
+    switch (id) {
+    case BuiltinBankId::Default: return defaultBank;
+    case BuiltinBankId::CppDsa: return cpp_dsaBank;
+    case BuiltinBankId::CurrentAffairs:
+    default: return current_affairsBank;
+    }
+}
+
+const QList<QuestionContentPtr>& builtinContents(BuiltinBankId id)
+{
+    switch (id) {
+    case BuiltinBankId::Default: {
+        static const QList<QuestionContentPtr> contents = buildContents(defaultBank);
+        return contents;
+    }
+    case BuiltinBankId::CppDsa: {
+        static const QList<QuestionContentPtr> contents = buildContents(cpp_dsaBank);
+        return contents;
+    }
+    case BuiltinBankId::CurrentAffairs:
+    default: {
+        static const QList<QuestionContentPtr> contents = buildContents(current_affairsBank);
+        return contents;
+    }
+    }
+}
+
+QList<QuizQuestion> builtinQuestions(BuiltinBankId id)
+{
+    const QList<QuestionContentPtr>& contents = builtinContents(id);
+    QList<QuizQuestion> questions;
+    questions.reserve(contents.size());
+    for (const QuestionContentPtr& content : contents) {
+        questions.append(QuizQuestion(content));
+    }
+    return questions;
+}
\ No newline at end of file
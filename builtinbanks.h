@@ -0,0 +1,44 @@
+#ifndef BUILTINBANKS_H
+#define BUILTINBANKS_H
+
+#include <QStringView>
+#include <QList>
+#include "quizquestion.h"
+
+// Question banks compiled into the application. Their sources are the
+// JSON files in questions/, turned into headers of constexpr records by
+// tools/genbank.py at build time (see app.pro). The records live in
+// read-only data: building the app's question lists from them allocates
+// nothing for the text, and each bank's content is built once per process
+// and shared by everything that asks for it.
+
+struct BuiltinQuestion {
+    QStringView question;
+    const QStringView* options;
+    int optionCount;
+    int correctIndex;
+    Difficulty difficulty;
+    QuestionType type;
+};
+
+struct BuiltinBank {
+    const BuiltinQuestion* questions;
+    int count;
+};
+
+enum class BuiltinBankId {
+    Default,        // questions/default.json
+    CppDsa,         // questions/cpp_dsa.json
+    CurrentAffairs  // questions/current_affairs.json
+};
+
+const BuiltinBank& builtinBank(BuiltinBankId id);
+
+// The bank's content, built on first use and kept for the life of the
+// process. Strings refer to the literals rather than copying them.
+const QList<QuestionContentPtr>& builtinContents(BuiltinBankId id);
+
+// Fresh questions over that content
+QList<QuizQuestion> builtinQuestions(BuiltinBankId id);
+
+#endif // BUILTINBANKS_H
\ No newline at end of file
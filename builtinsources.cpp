@@ -0,0 +1,253 @@
+#include "builtinsources.h"
+#include <QJsonArray>
+#include <QStringList>
+#include <algorithm>
+
+NewsApiSource::NewsApiSource()
+    : m_url("https://newsapi.org/v2/top-headlines")
+    , m_key(qEnvironmentVariable("NEWSAPI_KEY"))
+{
+}
+
+QString NewsApiSource::name() const
+{
+    return "newsapi";
+}
+
+void NewsApiSource::configure(const QVariantMap& settings)
+{
+    if (settings.contains("url")) m_url = settings.value("url").toUrl();
+    if (settings.contains("key")) m_key = settings.value("key").toString();
+}
+
+QUrlQuery NewsApiSource::query(int count) const
+{
+    QUrlQuery params;
+    params.addQueryItem("country", "us");
+    params.addQueryItem("pageSize", QString::number(count));
+    return params;
+}
+
+QUrl NewsApiSource::requestUrl(int count) const
+{
+    // Nothing to ask without a key
+    if (m_key.isEmpty()) return QUrl();
+    
+    QUrlQuery params = query(count);
+    params.addQueryItem("apiKey", m_key);
+    QUrl url(m_url);
+    url.setQuery(params);
+    return url;
+}
+
+QString NewsApiSource::cacheKey(int count) const
+{
+    return m_url.host() + m_url.path() + "?" + query(count).toString();
+}
+
+QString NewsApiSource::arrayKey() const
+{
+    return "articles";
+}
+
+QString NewsApiSource::statusKey() const
+{
+    return "status";
+}
+
+QJsonValue NewsApiSource::okStatus() const
+{
+    return QJsonValue("ok");
+}
+
+bool NewsApiSource::toQuestion(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) const
+{
+    return questionFromArticle(element, rng, question);
+}
+
+bool NewsApiSource::questionFromArticle(const QJsonObject& article, std::mt19937& rng, QuizQuestion& quizQuestion)
+{
+    QString title = article["title"].toString();
+    QString description = article["description"].toString();
+    if (title.isEmpty() || description.isEmpty()) return false;
+    
+    // Create question from news article
+    QString question = QString("What is the main topic of this news: %1?").arg(title);
+    
+    // Create options based on the article content
+    QStringList options;
+    options.append("Current Affairs"); // Correct answer
+    options.append("Sports");
+    options.append("Entertainment");
+    options.append("Technology");
+    
+    // Shuffle options with the response's generator, seeded once
+    std::shuffle(options.begin(), options.end(), rng);
+    
+    // Determine difficulty based on title length
+    Difficulty difficulty = Difficulty::Easy;
+    if (title.length() > 100) {
+        difficulty = Difficulty::Hard;
+    } else if (title.length() > 60) {
+        difficulty = Difficulty::Medium;
+    }
+    
+    quizQuestion = QuizQuestion(question, options, "Current Affairs", difficulty);
+    return true;
+}
+
+OpenTdbSource::OpenTdbSource()
+    : m_url("https://opentdb.com/api.php")
+{
+}
+
+QString OpenTdbSource::name() const
+{
+    return "opentdb";
+}
+
+void OpenTdbSource::configure(const QVariantMap& settings)
+{
+    if (settings.contains("url")) m_url = settings.value("url").toUrl();
+}
+
+QUrl OpenTdbSource::requestUrl(int count) const
+{
+    // At most 50 questions per call
+    QUrlQuery params;
+    params.addQueryItem("amount", QString::number(qBound(1, count, 50)));
+    params.addQueryItem("type", "multiple");
+    params.addQueryItem("encode", "url3986");
+    QUrl url(m_url);
+    url.setQuery(params);
+    return url;
+}
+
+QString OpenTdbSource::cacheKey(int count) const
+{
+    QUrl url = requestUrl(count);
+    return url.host() + url.path() + "?" + url.query();
+}
+
+QString OpenTdbSource::arrayKey() const
+{
+    return "results";
+}
+
+QString OpenTdbSource::statusKey() const
+{
+    return "response_code";
+}
+
+QJsonValue OpenTdbSource::okStatus() const
+{
+    return QJsonValue(0);
+}
+
+bool OpenTdbSource::toQuestion(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) const
+{
+    return questionFromTrivia(element, rng, question);
+}
+
+bool OpenTdbSource::questionFromTrivia(const QJsonObject& trivia, std::mt19937& rng, QuizQuestion& quizQuestion)
+{
+    // Requested percent-encoded, so every string decodes the same way
+    auto decode = [](const QJsonValue& value) {
+        return QUrl::fromPercentEncoding(value.toString().toUtf8());
+    };
+    QString question = decode(trivia["question"]);
+    QString correctAnswer = decode(trivia["correct_answer"]);
+    QJsonArray incorrectAnswers = trivia["incorrect_answers"].toArray();
+    if (question.isEmpty() || correctAnswer.isEmpty() || incorrectAnswers.isEmpty()) return false;
+    
+    QStringList options;
+    options.append(correctAnswer);
+    for (const QJsonValue& incorrect : incorrectAnswers) {
+        options.append(decode(incorrect));
+    }
+    
+    // Shuffle options with the response's generator, seeded once
+    std::shuffle(options.begin(), options.end(), rng);
+    
+    Difficulty difficulty = QuizQuestion::stringToDifficulty(decode(trivia["difficulty"]));
+    quizQuestion = QuizQuestion(question, options, correctAnswer, difficulty);
+    return true;
+}
+
+GeeksForGeeksSource::GeeksForGeeksSource()
+    : m_url("https://api.geeksforgeeks.org/problems/get-problems?category=all&difficulty=all&type=all")
+{
+}
+
+QString GeeksForGeeksSource::name() const
+{
+    return "geeksforgeeks";
+}
+
+void GeeksForGeeksSource::configure(const QVariantMap& settings)
+{
+    if (settings.contains("url")) m_url = settings.value("url").toUrl();
+}
+
+QUrl GeeksForGeeksSource::requestUrl(int count) const
+{
+    // The listing has no size parameter; parsing stops at count
+    Q_UNUSED(count);
+    return m_url;
+}
+
+QString GeeksForGeeksSource::cacheKey(int count) const
+{
+    QString key = m_url.host() + m_url.path() + "?" + m_url.query();
+    return count > 0 ? key + QString("#%1").arg(count) : key;
+}
+
+QString GeeksForGeeksSource::arrayKey() const
+{
+    return "results";
+}
+
+QString GeeksForGeeksSource::statusKey() const
+{
+    return "status";
+}
+
+QJsonValue GeeksForGeeksSource::okStatus() const
+{
+    return QJsonValue("SUCCESS");
+}
+
+bool GeeksForGeeksSource::toQuestion(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) const
+{
+    return questionFromProblem(element, rng, question);
+}
+
+bool GeeksForGeeksSource::questionFromProblem(const QJsonObject& problem, std::mt19937& rng, QuizQuestion& quizQuestion)
+{
+    QString title = problem["title"].toString();
+    QString difficultyStr = problem["difficulty"].toString();
+    if (title.isEmpty()) return false;
+    
+    // Create question from problem title
+    QString question = QString("What is the main concept tested in: %1?").arg(title);
+    
+    // Create options based on common DSA concepts
+    QStringList options;
+    options.append("Data Structures");
+    options.append("Algorithms");
+    options.append("Dynamic Programming");
+    options.append("Graph Theory");
+    
+    // Shuffle options with the response's generator, seeded once
+    std::shuffle(options.begin(), options.end(), rng);
+    
+    // Determine difficulty
+    Difficulty difficulty = Difficulty::Easy;
+    if (difficultyStr == "Hard") {
+        difficulty = Difficulty::Hard;
+    } else if (difficultyStr == "Medium") {
+        difficulty = Difficulty::Medium;
+    }
+    
+    quizQuestion = QuizQuestion(question, options, "Data Structures", difficulty);
+    return true;
@@ -0,0 +1,79 @@
+#ifndef BUILTINSOURCES_H
+#define BUILTINSOURCES_H
+
+#include <QUrlQuery>
+#include "questionsource.h"
+
+// The providers the application ships with. Each one's endpoint can be
+// moved with configure({"url", ...}).
+
+// Current affairs from NewsAPI top headlines, one question per article.
+// The API key comes from "key", else the NEWSAPI_KEY environment
+// variable; with neither the source is unconfigured.
+class NewsApiSource : public QuestionSource
+{
+public:
+    NewsApiSource();
+
+    QString name() const override;
+    void configure(const QVariantMap& settings) override;
+    QUrl requestUrl(int count) const override;
+    QString cacheKey(int count) const override;
+    QString arrayKey() const override;
+    QString statusKey() const override;
+    QJsonValue okStatus() const override;
+    bool toQuestion(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) const override;
+
+    static bool questionFromArticle(const QJsonObject& article, std::mt19937& rng, QuizQuestion& quizQuestion);
+
+private:
+    QUrlQuery query(int count) const;
+
+    QUrl m_url;
+    QString m_key;
+};
+
+// General knowledge from Open Trivia DB, asked percent-encoded so that no
+// HTML entities need decoding
+class OpenTdbSource : public QuestionSource
+{
+public:
+    OpenTdbSource();
+
+    QString name() const override;
+    void configure(const QVariantMap& settings) override;
+    QUrl requestUrl(int count) const override;
+    QString cacheKey(int count) const override;
+    QString arrayKey() const override;
+    QString statusKey() const override;
+    QJsonValue okStatus() const override;
+    bool toQuestion(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) const override;
+
+    static bool questionFromTrivia(const QJsonObject& trivia, std::mt19937& rng, QuizQuestion& quizQuestion);
+
+private:
+    QUrl m_url;
+};
+
+// Programming problems from GeeksforGeeks, one question per problem
+class GeeksForGeeksSource : public QuestionSource
+{
+public:
+    GeeksForGeeksSource();
+
+    QString name() const override;
+    void configure(const QVariantMap& settings) override;
+    QUrl requestUrl(int count) const override;
+    QString cacheKey(int count) const override;
+    QString arrayKey() const override;
+    QString statusKey() const override;
+    QJsonValue okStatus() const override;
+    bool toQuestion(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) const override;
+
+    static bool questionFromProblem(const QJsonObject& problem, std::mt19937& rng, QuizQuestion& quizQuestion);
+
+private:
+    QUrl m_url;
+};
+
+#endif // BUILTINSOURCES_H
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <QtCharts/QBarCategoryAxis>
 #include <QtCharts/QValueAxis>
 #include <QtCharts/QChart>
+#include <algorithm>
+#include <cmath>
 #include <QDebug> // Added for qDebug()
 #include <QPushButton> // Added for QPushButton
 #include <QTabWidget> // Added for QTabWidget
@@ -282,7 +284,7 @@ void ChartWidget::createTimeChart()
     QBarSeries* series = new QBarSeries();
     QBarSet* timeSet = new QBarSet("Time (seconds)");
     
-    QList<int> timePerQuestion = getTimePerQuestion();
+    QList<double> timePerQuestion = getTimePerQuestion();
     
     // Ensure we have some data
     if (timePerQuestion.isEmpty()) {
@@ -305,7 +307,9 @@ void ChartWidget::createTimeChart()
     series->attachAxis(axisX);
     
     QValueAxis* axisY = new QValueAxis();
-    axisY->setRange(0, 120); // 2 minutes max
+    // Scale to the slowest response, at least 10 seconds
+    double slowest = *std::max_element(timePerQuestion.begin(), timePerQuestion.end());
+    axisY->setRange(0, qMax(10.0, std::ceil(slowest * 1.1)));
     axisY->setTitleText("Time (seconds)");
     chart->addAxis(axisY, Qt::AlignLeft);
     series->attachAxis(axisY);
@@ -387,12 +391,12 @@ QMap<Difficulty, double> ChartWidget::getAccuracyByDifficulty() const
     return accuracy;
 }
 
-QList<int> ChartWidget::getTimePerQuestion() const
+QList<double> ChartWidget::getTimePerQuestion() const
 {
-    QList<int> times;
+    QList<double> times;
     
     for (const QuizQuestion& question : m_questions) {
-        times.append(question.getTimeSpent());
+        times.append(question.getTimeSpentMs() / 1000.0);
     }
     
     return times;
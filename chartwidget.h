@@ -72,7 +72,7 @@ private:
     QChart* createBarChart(const QString& title, QBarSeries* series);
     QMap<Difficulty, int> getDifficultyStats() const;
     QMap<Difficulty, double> getAccuracyByDifficulty() const;
-    QList<int> getTimePerQuestion() const;
+    QList<double> getTimePerQuestion() const;
 };
 
 #endif // CHARTWIDGET_H 
\ No newline at end of file
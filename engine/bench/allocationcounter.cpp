@@ -0,0 +1,51 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "benchmodes.h"
+
+// Replacements for the global allocation functions that count calls and
+// live bytes for the benchmarks. The array and sized forms forward here.
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::int64_t> liveBytes{0};
+
+// Each block carries its size in front, so frees can be counted too; 16
+// bytes keep the block as aligned as malloc's
+constexpr std::size_t Header = 16;
+
+}
+
+void* operator new(std::size_t size)
+{
+    void* block = std::malloc(size + Header);
+    if (!block) throw std::bad_alloc();
+    *static_cast<std::size_t*>(block) = size;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    return static_cast<char*>(block) + Header;
+}
+
+void operator delete(void* memory) noexcept
+{
+    if (!memory) return;
+    void* block = static_cast<char*>(memory) - Header;
+    liveBytes.fetch_sub(static_cast<std::int64_t>(*static_cast<std::size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+std::uint64_t allocationCount()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+std::int64_t allocatedBytes()
+{
+    return liveBytes.load(std::memory_order_relaxed);
+}
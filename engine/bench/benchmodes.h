@@ -0,0 +1,40 @@
+#ifndef BENCHMODES_H
+#define BENCHMODES_H
+
+#include <cstdint>
+#include <ostream>
+#include "quizengine.h"
+
+// Modes of the enginebench tool. Each writes its report to out and
+// returns the process exit code: 0 on success, 1 if a check failed.
+
+// operator new calls made so far by the process, and the bytes they hold
+// now; enginebench replaces the global allocation functions to count them
+std::uint64_t allocationCount();
+std::int64_t allocatedBytes();
+
+// A bank of count questions with difficulties drawn evenly from seed;
+// option 0 is the right answer to each
+EngineBankPtr makeSyntheticBank(int count, std::uint64_t seed);
+
+// WeightedSampler after millions of random updates: no draw, including
+// one at the very top of the total, returns a removed item.
+int runSamplerCheck(std::ostream& out);
+
+// Lazy per-difficulty weight factors against the eager per-question
+// reweighting they replaced: same seed, same answer sequence, same
+// weights and the same selection distribution.
+int runLazyWeightsCheck(std::ostream& out);
+
+// Every registered selection strategy over synthetic banks of 1k, 100k
+// and 1M questions: start time, per-selection latency (mean, p50, p99),
+// heap allocations per selection and the difficulty mix it picked.
+int runStrategyBenchmark(std::ostream& out);
+
+// SessionHost on one worker thread over a 30-question bank: answer+next
+// steps and complete sessions per second, heap bytes per session split
+// into a fixed part and a part per question, and the heap held by 100k
+// concurrent sessions.
+int runSessionBenchmark(std::ostream& out);
+
+#endif // BENCHMODES_H
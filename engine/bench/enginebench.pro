@@ -0,0 +1,26 @@
+# Headless engine checks and benchmarks: a plain C++17 console program
+# linked against the engine library, with no Qt.
+# Run with: enginebench <mode>, or with no mode for the list
+
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+TARGET = enginebench
+
+INCLUDEPATH += $$PWD/..
+DEPENDPATH += $$PWD/..
+LIBS += -L$$OUT_PWD/.. -lquizengine
+win32-msvc*: PRE_TARGETDEPS += $$OUT_PWD/../quizengine.lib
+else: PRE_TARGETDEPS += $$OUT_PWD/../libquizengine.a
+
+SOURCES += \
+    main.cpp \
+    allocationcounter.cpp \
+    samplercheck.cpp \
+    lazyweights.cpp \
+    strategybench.cpp \
+    sessionbench.cpp
+
+HEADERS += \
+    benchmodes.h
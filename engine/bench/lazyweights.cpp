@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "benchmodes.h"
+#include "quizengine.h"
+
+namespace {
+
+double baseWeight(Difficulty difficulty)
+{
+    switch (difficulty) {
+        case Difficulty::Easy: return 1.0;
+        case Difficulty::Medium: return 1.5;
+        case Difficulty::Hard: return 2.0;
+    }
+    return 1.0;
+}
+
+// The reweighting selection used before the factors were lazy: after every
+// answer, each unanswered question's weight is rewritten in place, and a
+// draw scans the cumulative weights
+class EagerWeights
+{
+public:
+    explicit EagerWeights(const EngineBank& bank)
+    {
+        for (const EngineQuestion& question : bank) {
+            m_difficulty.push_back(question.difficulty);
+            m_weights.push_back(baseWeight(question.difficulty));
+        }
+    }
+
+    // Takes the per-difficulty metrics from the engine, which updated them
+    // for the same answer; only the weights are under test
+    void answer(int index, const QuizEngine& engine)
+    {
+        m_weights[index] = 0.0;
+        for (std::size_t i = 0; i < m_weights.size(); ++i) {
+            if (m_weights[i] <= 0.0) continue;
+
+            double accuracy = engine.accuracy(m_difficulty[i]);
+            double avgTime = engine.averageTime(m_difficulty[i]);
+            if (accuracy < 0.3) {
+                m_weights[i] *= 0.8;
+            } else if (accuracy > 0.7) {
+                m_weights[i] *= 1.2;
+            }
+            if (avgTime > 120) {
+                m_weights[i] *= 0.9;
+            }
+        }
+    }
+
+    double weight(int index) const { return m_weights[index]; }
+
+    double total() const
+    {
+        double sum = 0.0;
+        for (double weight : m_weights) sum += weight;
+        return sum;
+    }
+
+    int sample(std::mt19937_64& rng) const
+    {
+        double value = std::uniform_real_distribution<double>(0.0, total())(rng);
+        int last = -1;
+        for (std::size_t i = 0; i < m_weights.size(); ++i) {
+            if (m_weights[i] <= 0.0) continue;
+            last = static_cast<int>(i);
+            if (value < m_weights[i]) return last;
+            value -= m_weights[i];
+        }
+        return last;
+    }
+
+private:
+    std::vector<Difficulty> m_difficulty;
+    std::vector<double> m_weights;
+};
+
+// Half the summed absolute difference between a histogram of draws and
+// the exact probabilities: 0 for identical distributions, 1 for disjoint
+double totalVariation(const std::vector<int>& histogram, int draws, const EagerWeights& eager, int count)
+{
+    double total = eager.total();
+    double distance = 0.0;
+    for (int i = 0; i < count; ++i) {
+        distance += std::fabs(double(histogram[i]) / draws - eager.weight(i) / total);
+    }
+    return distance / 2.0;
+}
+
+}
+
+int runLazyWeightsCheck(std::ostream& out)
+{
+    const int count = 240;
+    const int draws = 200000;
+    const double maxWeightError = 1e-9; // relative, from rounding alone
+    const double maxDistance = 0.03;    // sampling noise at this many draws is ~0.01
+    bool passed = true;
+
+    for (std::uint64_t seed : {1u, 2u, 3u}) {
+        // A bank of mixed difficulty and a fixed answer script: each
+        // question answered once in a shuffled order, mostly right on easy
+        // ones and mostly wrong on hard ones, with hard ones taking longer
+        std::mt19937_64 script(seed);
+        auto bank = std::make_shared<EngineBank>(count);
+        for (EngineQuestion& question : *bank) {
+            question.difficulty = static_cast<Difficulty>(script() % 3);
+            question.correctIndex = 0;
+        }
+        std::vector<int> order(count);
+        for (int i = 0; i < count; ++i) order[i] = i;
+        std::shuffle(order.begin(), order.end(), script);
+
+        QuizEngine engine(seed);
+        engine.start(bank, 0);
+        EagerWeights eager(*bank);
+        std::mt19937_64 eagerRng(seed);
+
+        std::uint64_t now = 0;
+        double worstError = 0.0;
+        double worstLazy = 0.0;
+        double worstEager = 0.0;
+        for (int step = 0; step < count - 10; ++step) {
+            int index = order[step];
+            int level = static_cast<int>((*bank)[index].difficulty);
+            double rightChance = 0.9 - 0.4 * level;
+            bool right = std::uniform_real_distribution<double>(0.0, 1.0)(script) < rightChance;
+            now += 20000 + script() % (60000 + 120000 * level);
+
+            engine.goTo(index, now - 1000);
+            engine.answer(right ? 0 : 1, now);
+            eager.answer(index, engine);
+
+            // Same effective weight for every question
+            for (int i = 0; i < count; ++i) {
+                double expected = eager.weight(i);
+                double actual = engine.effectiveWeight(i);
+                double error = expected > 0.0 ? std::fabs(actual - expected) / expected : std::fabs(actual);
+                worstError = std::max(worstError, error);
+            }
+
+            // Same distribution of draws, every 46 answers
+            if (step % 46 != 0) continue;
+            std::vector<int> lazyHistogram(count, 0);
+            std::vector<int> eagerHistogram(count, 0);
+            for (int draw = 0; draw < draws; ++draw) {
+                int lazy = engine.sampleByWeight();
+                if (lazy >= 0) lazyHistogram[lazy]++;
+                eagerHistogram[eager.sample(eagerRng)]++;
+            }
+            worstLazy = std::max(worstLazy, totalVariation(lazyHistogram, draws, eager, count));
+            worstEager = std::max(worstEager, totalVariation(eagerHistogram, draws, eager, count));
+        }
+
+        bool ok = worstError <= maxWeightError && worstLazy <= maxDistance;
+        passed = passed && ok;
+        out << "seed " << seed << ": weight error " << worstError
+            << ", distance from eager probabilities: lazy " << worstLazy
+            << ", eager " << worstEager << (ok ? "  ok" : "  FAILED") << "\n";
+    }
+
+    out << (passed ? "lazy factors match eager reweighting\n" : "lazy factors differ from eager reweighting\n");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include "benchmodes.h"
+
+namespace {
+
+struct Mode {
+    const char* name;
+    const char* description;
+    int (*run)(std::ostream& out);
+};
+
+const Mode modes[] = {
+    {"sampler", "check that weighted draws never return a removed item", runSamplerCheck},
+    {"lazy-weights", "check lazy weight factors against eager reweighting", runLazyWeightsCheck},
+    {"strategies", "selection latency, allocations and difficulty mix per strategy", runStrategyBenchmark},
+    {"sessions", "session host throughput per core and memory per session", runSessionBenchmark},
+};
+
+}
+
+EngineBankPtr makeSyntheticBank(int count, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    auto bank = std::make_shared<EngineBank>(count);
+    for (EngineQuestion& question : *bank) {
+        question.difficulty = static_cast<Difficulty>(rng() % 3);
+        question.correctIndex = 0;
+    }
+    return bank;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 2) {
+        for (const Mode& mode : modes) {
+            if (std::strcmp(argv[1], mode.name) == 0) return mode.run(std::cout);
+        }
+    }
+
+    std::cerr << "usage: enginebench <mode>\n";
+    for (const Mode& mode : modes) {
+        std::cerr << "  " << mode.name << "  " << mode.description << "\n";
+    }
+    return 2;
+}
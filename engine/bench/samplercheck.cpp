@@ -0,0 +1,35 @@
+#include <random>
+#include <vector>
+#include "benchmodes.h"
+#include "weightedsampler.h"
+
+int runSamplerCheck(std::ostream& out)
+{
+    // Weights of very different sizes, updated and removed at random, so
+    // rounding leftovers build up in the tree; after every update a draw
+    // inside the total and one at its very top must land on an active item
+    const int count = 1000;
+    const int updates = 2000000;
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<double> weights(count);
+    for (double& weight : weights) weight = unit(rng) * 1e-3 + unit(rng) * 1e3;
+    WeightedSampler sampler;
+    sampler.reset(weights);
+
+    long removedDraws = 0;
+    for (int update = 0; update < updates; ++update) {
+        int index = static_cast<int>(rng() % count);
+        sampler.setWeight(index, rng() % 3 ? unit(rng) * 1e3 : 0.0);
+
+        double total = sampler.totalWeight();
+        for (double value : {unit(rng) * total, total}) {
+            int drawn = sampler.sample(value);
+            if (drawn >= 0 && sampler.isRemoved(drawn)) removedDraws++;
+        }
+    }
+
+    out << updates << " updates over " << count << " items: " << removedDraws << " draws of a removed item\n";
+    return removedDraws == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include "benchmodes.h"
+#include "sessionhost.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Answers every question of the session and moves on after each, with a
+// simulated second per question; every fourth answer is wrong
+void playToEnd(QuizEngine& engine, std::uint64_t& steps)
+{
+    std::uint64_t now = 0;
+    do {
+        now += 1000;
+        engine.answer(steps % 4 == 0 ? 1 : 0, now);
+        steps++;
+    } while (engine.next(now) >= 0);
+}
+
+// Heap bytes each of count sessions holds once opened and played through
+double bytesPerSession(int questions, int count)
+{
+    SessionHost host(makeSyntheticBank(questions, 5), 1);
+    host.wait();
+    std::int64_t base = allocatedBytes();
+
+    std::uint64_t steps = 0;
+    for (int i = 0; i < count; ++i) {
+        SessionHost::SessionId id = host.open(i + 1);
+        host.post(id, [&steps](QuizEngine& engine) { playToEnd(engine, steps); });
+    }
+    host.wait();
+    return double(allocatedBytes() - base) / count;
+}
+
+}
+
+int runSessionBenchmark(std::ostream& out)
+{
+    const int questions = 30;
+    out << std::fixed;
+
+    // Throughput on one worker thread: sessions opened, played through
+    // and closed back to back, so slots and engines are reused
+    {
+        SessionHost host(makeSyntheticBank(questions, 5), 1);
+        const int sessions = 200000;
+        std::uint64_t steps = 0; // only touched on the worker thread
+        Clock::time_point started = Clock::now();
+        for (int i = 0; i < sessions; ++i) {
+            SessionHost::SessionId id = host.open(i + 1);
+            host.post(id, [&steps](QuizEngine& engine) { playToEnd(engine, steps); });
+            host.close(id);
+        }
+        host.wait();
+        double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+        out << "throughput, 1 worker, " << questions << " questions per session:\n"
+            << "  " << std::setprecision(2) << steps / seconds / 1e6 << "M answer+next steps/s, "
+            << sessions / seconds * 60 / 1e6 << "M complete sessions/min\n";
+    }
+
+    // Memory: two bank sizes separate the fixed part from the part that
+    // grows with the bank
+    const int sample = 10000;
+    double small = bytesPerSession(questions, sample);
+    double large = bytesPerSession(10 * questions, sample);
+    double perQuestion = (large - small) / (9 * questions);
+    double fixed = small - perQuestion * questions;
+    out << "memory per played session (heap):\n"
+        << "  " << std::setprecision(0) << small << " bytes at " << questions << " questions = "
+        << fixed << " fixed + " << std::setprecision(1) << perQuestion << " per question\n";
+
+    // Many sessions at once, all open and played through
+    {
+        const int sessions = 100000;
+        SessionHost host(makeSyntheticBank(questions, 5), 1);
+        host.wait();
+        std::int64_t base = allocatedBytes();
+        std::uint64_t steps = 0;
+        for (int i = 0; i < sessions; ++i) {
+            SessionHost::SessionId id = host.open(i + 1);
+            host.post(id, [&steps](QuizEngine& engine) { playToEnd(engine, steps); });
+        }
+        host.wait();
+        out << sessions / 1000 << "k concurrent sessions: " << std::setprecision(0)
+            << double(allocatedBytes() - base) / (1024 * 1024) << " MB heap\n";
+    }
+    return 0;
+}
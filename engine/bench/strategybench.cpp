@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmodes.h"
+#include "quizengine.h"
+#include "selectionstrategy.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double percentile(std::vector<double> samples, double fraction)
+{
+    if (samples.empty()) return 0.0;
+    std::size_t at = std::min(samples.size() - 1, static_cast<std::size_t>(samples.size() * fraction));
+    std::nth_element(samples.begin(), samples.begin() + at, samples.end());
+    return samples[at];
+}
+
+}
+
+int runStrategyBenchmark(std::ostream& out)
+{
+    // Each run answers the current question, then asks the strategy for the
+    // next one, up to this many times; only the next() calls are measured
+    const int maxSelections = 10000;
+
+    out << std::left << std::setw(10) << "questions" << std::setw(13) << "strategy"
+        << std::right << std::setw(10) << "start ms" << std::setw(11) << "mean ns"
+        << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(11) << "allocs/op"
+        << "  easy/medium/hard %\n";
+
+    for (int count : {1000, 100000, 1000000}) {
+        EngineBankPtr bank = makeSyntheticBank(count, 42);
+        for (const std::string& name : SelectionStrategyRegistry::instance().names()) {
+            QuizEngine engine(7);
+            engine.setSelectionStrategy(name);
+
+            Clock::time_point started = Clock::now();
+            engine.start(bank, 0);
+            double startMs = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+
+            // Same answers for every strategy: mostly right on easy
+            // questions, mostly wrong on hard ones, hard ones slower
+            std::mt19937_64 script(11);
+            std::vector<double> latencies;
+            latencies.reserve(maxSelections);
+            int picked[3] = {0, 0, 0};
+            std::uint64_t allocations = 0;
+            std::uint64_t now = 0;
+            for (int step = 0; step < maxSelections; ++step) {
+                int level = static_cast<int>((*bank)[engine.currentQuestionIndex()].difficulty);
+                bool right = std::uniform_real_distribution<double>(0.0, 1.0)(script) < 0.9 - 0.4 * level;
+                now += 20000 + script() % (60000 + 120000 * level);
+                engine.answer(right ? 0 : 1, now);
+
+                std::uint64_t allocationsBefore = allocationCount();
+                Clock::time_point before = Clock::now();
+                int next = engine.next(now);
+                Clock::time_point after = Clock::now();
+                allocations += allocationCount() - allocationsBefore;
+                if (next < 0) break;
+
+                latencies.push_back(std::chrono::duration<double, std::nano>(after - before).count());
+                picked[static_cast<int>((*bank)[next].difficulty)]++;
+            }
+
+            double mean = 0.0;
+            for (double latency : latencies) mean += latency;
+            int selections = static_cast<int>(latencies.size());
+            if (selections > 0) mean /= selections;
+            double share = selections > 0 ? 100.0 / selections : 0.0;
+
+            out << std::left << std::setw(10) << count << std::setw(13) << name << std::right
+                << std::fixed << std::setprecision(2) << std::setw(10) << startMs
+                << std::setprecision(0) << std::setw(11) << mean
+                << std::setw(10) << percentile(latencies, 0.5) << std::setw(10) << percentile(latencies, 0.99)
+                << std::setprecision(2) << std::setw(11) << (selections > 0 ? double(allocations) / selections : 0.0)
+                << std::setprecision(0) << "  " << picked[0] * share << "/" << picked[1] * share
+                << "/" << picked[2] * share << "\n";
+        }
+    }
+    return 0;
+}
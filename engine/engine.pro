@@ -0,0 +1,31 @@
+# Headless quiz engine: plain C++17, no Qt, built as a static library and
+# linked into the application (and into any simulation or load-test driver)
+
+TEMPLATE = lib
+CONFIG += staticlib c++17
+CONFIG -= qt
+
+TARGET = quizengine
+
+SOURCES += \
+    quizengine.cpp \
+    sessionhost.cpp \
+    sessionjournal.cpp \
+    timerwheel.cpp \
+    weightedsampler.cpp \
+    indexbitset.cpp \
+    selectionstrategy.cpp \
+    jsonpullparser.cpp
+
+HEADERS += \
+    quiztypes.h \
+    quizengine.h \
+    sessionhost.h \
+    sessionjournal.h \
+    timerwheel.h \
+    weightedsampler.h \
+    indexbitset.h \
+    indexedheap.h \
+    spscqueue.h \
+    selectionstrategy.h \
+    jsonpullparser.h
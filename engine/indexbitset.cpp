@@ -0,0 +1,151 @@
+#include "indexbitset.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+const std::uint64_t kAllSet = ~std::uint64_t(0);
+
+inline int countTrailingZeros(std::uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+inline int wordCount(int bits)
+{
+    return (bits + 63) / 64;
+}
+
+// Bits at and above 'used' in a word of 64 are padding and read as set
+inline std::uint64_t paddingMask(int used)
+{
+    return used >= 64 ? 0 : (kAllSet << used);
+}
+
+}
+
+IndexBitset::IndexBitset()
+    : m_size(0)
+    , m_count(0)
+    , m_hint(0)
+{
+}
+
+void IndexBitset::resize(int size)
+{
+    if (size < 0) size = 0;
+
+    // Strip the padding of the old last word before growing
+    if (!m_words.empty() && m_size % 64 != 0) {
+        m_words.back() &= ~paddingMask(m_size % 64);
+    }
+
+    // Drop bits past the new size from the count when shrinking
+    for (int i = size; i < m_size; ++i) {
+        if (test(i)) m_count--;
+    }
+
+    m_words.resize(wordCount(size), 0);
+    m_size = size;
+
+    if (!m_words.empty() && m_size % 64 != 0) {
+        m_words.back() |= paddingMask(m_size % 64);
+    }
+
+    rebuildSummary();
+}
+
+void IndexBitset::clear()
+{
+    m_words.clear();
+    m_fullWords.clear();
+    m_size = 0;
+    m_count = 0;
+    m_hint = 0;
+}
+
+int IndexBitset::size() const
+{
+    return m_size;
+}
+
+int IndexBitset::count() const
+{
+    return m_count;
+}
+
+bool IndexBitset::isFull() const
+{
+    return m_count == m_size;
+}
+
+bool IndexBitset::test(int index) const
+{
+    if (index < 0 || index >= m_size) return false;
+    return (m_words[index / 64] >> (index % 64)) & 1;
+}
+
+void IndexBitset::set(int index)
+{
+    if (index < 0 || index >= m_size || test(index)) return;
+
+    const int word = index / 64;
+    m_words[word] |= std::uint64_t(1) << (index % 64);
+    m_count++;
+    markWord(word);
+}
+
+void IndexBitset::reset(int index)
+{
+    if (index < 0 || index >= m_size || !test(index)) return;
+
+    const int word = index / 64;
+    m_words[word] &= ~(std::uint64_t(1) << (index % 64));
+    m_count--;
+    m_fullWords[word / 64] &= ~(std::uint64_t(1) << (word % 64));
+    if (word / 64 < m_hint) m_hint = word / 64;
+}
+
+int IndexBitset::findFirstUnset() const
+{
+    const int summaryWords = static_cast<int>(m_fullWords.size());
+    for (int s = m_hint; s < summaryWords; ++s) {
+        const std::uint64_t freeWords = ~m_fullWords[s];
+        if (freeWords == 0) continue;
+
+        m_hint = s;
+        const int word = s * 64 + countTrailingZeros(freeWords);
+        return word * 64 + countTrailingZeros(~m_words[word]);
+    }
+
+    m_hint = summaryWords;
+    return -1;
+}
+
+void IndexBitset::rebuildSummary()
+{
+    const int words = static_cast<int>(m_words.size());
+    m_fullWords.assign(wordCount(words), 0);
+    if (!m_fullWords.empty() && words % 64 != 0) {
+        m_fullWords.back() = paddingMask(words % 64);
+    }
+    for (int w = 0; w < words; ++w) {
+        markWord(w);
+    }
+    m_hint = 0;
+}
+
+void IndexBitset::markWord(int word)
+{
+    if (m_words[word] == kAllSet) {
+        m_fullWords[word / 64] |= std::uint64_t(1) << (word % 64);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef INDEXBITSET_H
+#define INDEXBITSET_H
+
+#include <cstdint>
+#include <vector>
+
+// Dense bitset over [0, size) with a one-word-per-64-words summary of
+// which words are completely set. findFirstUnset() skips full regions 4096
+// bits at a time using count-trailing-zeros, and remembers where the first
+// free bit can be so repeated lookups on a filling set are amortized O(1).
+//
+// A 1M-entry set costs ~125 KB of words plus ~2 KB of summary.
+class IndexBitset
+{
+public:
+    IndexBitset();
+
+    void resize(int size); // keeps existing bits, new bits are unset
+    void clear();
+
+    int size() const;
+    int count() const;
+    bool isFull() const;
+
+    bool test(int index) const;
+    void set(int index);
+    void reset(int index);
+
+    // Lowest index whose bit is unset, or -1 when every bit is set
+    int findFirstUnset() const;
+
+private:
+    std::vector<std::uint64_t> m_words;
+    std::vector<std::uint64_t> m_fullWords; // bit w set when m_words[w] is full
+    int m_size;
+    int m_count;
+    mutable int m_hint; // no summary word before this one has a free bit
+
+    void rebuildSummary();
+    void markWord(int word);
+};
+
+#endif // INDEXBITSET_H
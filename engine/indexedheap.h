@@ -0,0 +1,170 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <vector>
+
+// Indexed d-ary max-heap over item indices in [0, capacity). Each item is
+// stored at most once and its position is tracked, so its priority can be
+// raised or lowered in place (decrease-key) and it can be removed without
+// searching. Ties go to the lower index, so the order is deterministic.
+//
+//   top        O(1)
+//   push/pop   O(log_d n)
+//   update     O(log_d n)
+//   remove     O(log_d n)
+//
+// A fan-out of 4 keeps sift-down cheap while making the tree half as deep
+// as a binary heap.
+template <int Arity = 4>
+class IndexedHeap
+{
+    static_assert(Arity >= 2, "IndexedHeap needs at least two children per node");
+
+public:
+    IndexedHeap() = default;
+
+    void reset(int capacity)
+    {
+        m_heap.clear();
+        m_position.assign(capacity > 0 ? capacity : 0, -1);
+        m_priority.assign(capacity > 0 ? capacity : 0, 0.0);
+    }
+
+    void clear()
+    {
+        reset(0);
+    }
+
+    int capacity() const { return static_cast<int>(m_position.size()); }
+    int size() const { return static_cast<int>(m_heap.size()); }
+    bool isEmpty() const { return m_heap.empty(); }
+
+    bool contains(int index) const
+    {
+        return index >= 0 && index < capacity() && m_position[index] != -1;
+    }
+
+    double priority(int index) const
+    {
+        return contains(index) ? m_priority[index] : 0.0;
+    }
+
+    int top() const
+    {
+        return m_heap.empty() ? -1 : m_heap.front();
+    }
+
+    double topPriority() const
+    {
+        return m_heap.empty() ? 0.0 : m_priority[m_heap.front()];
+    }
+
+    // Inserts the item, or changes its priority if it is already queued
+    void push(int index, double priority)
+    {
+        if (index < 0) return;
+        if (index >= capacity()) {
+            m_position.resize(index + 1, -1);
+            m_priority.resize(index + 1, 0.0);
+        }
+        if (contains(index)) {
+            update(index, priority);
+            return;
+        }
+
+        m_priority[index] = priority;
+        m_position[index] = size();
+        m_heap.push_back(index);
+        siftUp(size() - 1);
+    }
+
+    void update(int index, double priority)
+    {
+        if (!contains(index)) return;
+
+        const double old = m_priority[index];
+        m_priority[index] = priority;
+        if (priority > old) {
+            siftUp(m_position[index]);
+        } else if (priority < old) {
+            siftDown(m_position[index]);
+        }
+    }
+
+    int pop()
+    {
+        const int index = top();
+        remove(index);
+        return index;
+    }
+
+    void remove(int index)
+    {
+        if (!contains(index)) return;
+
+        const int pos = m_position[index];
+        const int last = size() - 1;
+        if (pos != last) {
+            place(pos, m_heap[last]);
+        }
+        m_heap.pop_back();
+        m_position[index] = -1;
+
+        if (pos < size()) {
+            const int moved = m_heap[pos];
+            siftUp(pos);
+            siftDown(m_position[moved]);
+        }
+    }
+
+private:
+    std::vector<int> m_heap;        // heap-ordered item indices
+    std::vector<int> m_position;    // item index -> heap slot, -1 if absent
+    std::vector<double> m_priority; // item index -> priority
+
+    bool before(int a, int b) const
+    {
+        if (m_priority[a] != m_priority[b]) return m_priority[a] > m_priority[b];
+        return a < b;
+    }
+
+    void place(int pos, int index)
+    {
+        m_heap[pos] = index;
+        m_position[index] = pos;
+    }
+
+    void siftUp(int pos)
+    {
+        const int index = m_heap[pos];
+        while (pos > 0) {
+            const int parent = (pos - 1) / Arity;
+            if (!before(index, m_heap[parent])) break;
+            place(pos, m_heap[parent]);
+            pos = parent;
+        }
+        place(pos, index);
+    }
+
+    void siftDown(int pos)
+    {
+        const int n = size();
+        const int index = m_heap[pos];
+        while (true) {
+            const int first = pos * Arity + 1;
+            if (first >= n) break;
+
+            int best = first;
+            const int end = first + Arity < n ? first + Arity : n;
+            for (int child = first + 1; child < end; ++child) {
+                if (before(m_heap[child], m_heap[best])) best = child;
+            }
+            if (!before(m_heap[best], index)) break;
+            place(pos, m_heap[best]);
+            pos = best;
+        }
+        place(pos, index);
+    }
+};
+
+#endif // INDEXEDHEAP_H
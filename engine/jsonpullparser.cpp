@@ -0,0 +1,395 @@
+#include "jsonpullparser.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <locale>
+#include <sstream>
+
+namespace {
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void putUtf8(std::string& out, std::uint32_t code)
+{
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+// JSON number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isNumber(const std::string& text)
+{
+    std::size_t i = 0;
+    std::size_t size = text.size();
+    if (i < size && text[i] == '-') ++i;
+    if (i < size && text[i] == '0') {
+        ++i;
+    } else if (i < size && isDigit(text[i])) {
+        while (i < size && isDigit(text[i])) ++i;
+    } else {
+        return false;
+    }
+    if (i < size && text[i] == '.') {
+        ++i;
+        if (i == size || !isDigit(text[i])) return false;
+        while (i < size && isDigit(text[i])) ++i;
+    }
+    if (i < size && (text[i] == 'e' || text[i] == 'E')) {
+        ++i;
+        if (i < size && (text[i] == '+' || text[i] == '-')) ++i;
+        if (i == size || !isDigit(text[i])) return false;
+        while (i < size && isDigit(text[i])) ++i;
+    }
+    return i == size;
+}
+
+}
+
+JsonPullParser::JsonPullParser()
+    : m_pos(0)
+    , m_scan(0)
+    , m_state(State::Value)
+    , m_boolean(false)
+    , m_finished(false)
+    , m_failed(false)
+    , m_skipTo(-1)
+    , m_maxTokenSize(16 * 1024 * 1024)
+    , m_maxDepth(256)
+{
+}
+
+void JsonPullParser::feed(const char* data, std::size_t size)
+{
+    // Consumed bytes are dropped once they are at least half the buffer,
+    // so it holds at most about twice the unconsumed input
+    if (m_pos > 0 && m_pos * 2 >= m_buffer.size()) {
+        m_buffer.erase(0, m_pos);
+        m_pos = 0;
+    }
+    m_buffer.append(data, size);
+}
+
+void JsonPullParser::feed(const std::string& data)
+{
+    feed(data.data(), data.size());
+}
+
+void JsonPullParser::finish()
+{
+    m_finished = true;
+}
+
+JsonPullParser::Token JsonPullParser::next()
+{
+    for (;;) {
+        Token token = readToken();
+        if (m_skipTo < 0 || token == Token::NeedMore || token == Token::Error) {
+            return token;
+        }
+        if (depth() == m_skipTo) {
+            // The skipped container just closed
+            m_skipTo = -1;
+        }
+    }
+}
+
+void JsonPullParser::skipContainer()
+{
+    if (!m_stack.empty()) {
+        m_skipTo = depth() - 1;
+    }
+}
+
+const std::string& JsonPullParser::text() const
+{
+    return m_text;
+}
+
+double JsonPullParser::number() const
+{
+    // Independent of the global locale's decimal point
+    std::istringstream in(m_text);
+    in.imbue(std::locale::classic());
+    double value = 0.0;
+    in >> value;
+    return value;
+}
+
+bool JsonPullParser::boolean() const
+{
+    return m_boolean;
+}
+
+int JsonPullParser::depth() const
+{
+    return static_cast<int>(m_stack.size());
+}
+
+const std::string& JsonPullParser::errorString() const
+{
+    return m_error;
+}
+
+void JsonPullParser::setMaxTokenSize(std::size_t bytes)
+{
+    m_maxTokenSize = bytes;
+}
+
+void JsonPullParser::setMaxDepth(int depth)
+{
+    m_maxDepth = depth;
+}
+
+JsonPullParser::Token JsonPullParser::readToken()
+{
+    if (m_failed) return Token::Error;
+
+    for (;;) {
+        while (m_pos < m_buffer.size() && isSpace(m_buffer[m_pos])) {
+            ++m_pos;
+        }
+        if (m_pos == m_buffer.size()) {
+            if (!m_finished) return Token::NeedMore;
+            return m_state == State::Done ? Token::End : fail("unexpected end of input");
+        }
+
+        char c = m_buffer[m_pos];
+        if (m_state == State::Done) {
+            return fail("unexpected data after the document");
+        }
+        if (m_state == State::Colon) {
+            if (c != ':') return fail("expected ':' after a key");
+            ++m_pos;
+            m_state = State::Value;
+            continue;
+        }
+        if (m_state == State::CommaOrEnd && c == ',') {
+            ++m_pos;
+            m_state = m_stack.back() == '{' ? State::Key : State::Value;
+            continue;
+        }
+
+        if (c == '}' || c == ']') {
+            char open = c == '}' ? '{' : '[';
+            bool allowed = m_state == State::CommaOrEnd
+                || (c == '}' && m_state == State::KeyOrEnd)
+                || (c == ']' && m_state == State::ValueOrEnd);
+            if (!allowed || m_stack.empty() || m_stack.back() != open) {
+                return fail(std::string("unexpected '") + c + "'");
+            }
+            m_stack.pop_back();
+            ++m_pos;
+            return finishValue(c == '}' ? Token::EndObject : Token::EndArray);
+        }
+        if (m_state == State::CommaOrEnd) {
+            return fail("expected ',' or the end of the container");
+        }
+        if (m_state == State::Key || m_state == State::KeyOrEnd) {
+            if (c != '"') return fail("expected a key");
+            return readString(Token::Key);
+        }
+
+        switch (c) {
+        case '{':
+        case '[':
+            if (depth() >= m_maxDepth) return fail("nesting too deep");
+            m_stack.push_back(c);
+            ++m_pos;
+            m_state = c == '{' ? State::KeyOrEnd : State::ValueOrEnd;
+            return c == '{' ? Token::StartObject : Token::StartArray;
+        case '"':
+            return readString(Token::String);
+        case 't':
+            return readLiteral("true", Token::Bool);
+        case 'f':
+            return readLiteral("false", Token::Bool);
+        case 'n':
+            return readLiteral("null", Token::Null);
+        default:
+            if (c == '-' || isDigit(c)) return readNumber();
+            return fail(std::string("unexpected character '") + c + "'");
+        }
+    }
+}
+
+JsonPullParser::Token JsonPullParser::fail(const std::string& message)
+{
+    m_failed = true;
+    m_error = message;
+    return Token::Error;
+}
+
+JsonPullParser::Token JsonPullParser::finishValue(Token token)
+{
+    m_state = m_stack.empty() ? State::Done : State::CommaOrEnd;
+    return token;
+}
+
+JsonPullParser::Token JsonPullParser::readString(Token token)
+{
+    // Find the closing quote, resuming where the last attempt stopped
+    std::size_t begin = m_pos + 1;
+    std::size_t i = begin + m_scan;
+    for (;;) {
+        if (i >= m_buffer.size()) {
+            m_scan = i - begin;
+            return needMore();
+        }
+        char c = m_buffer[i];
+        if (c == '"') break;
+        if (c == '\\') {
+            if (i + 1 >= m_buffer.size()) {
+                m_scan = i - begin;
+                return needMore();
+            }
+            i += 2;
+            continue;
+        }
+        ++i;
+    }
+
+    if (!decodeString(begin, i)) return Token::Error;
+    m_pos = i + 1;
+    m_scan = 0;
+    if (token == Token::Key) {
+        m_state = State::Colon;
+        return Token::Key;
+    }
+    return finishValue(Token::String);
+}
+
+JsonPullParser::Token JsonPullParser::readNumber()
+{
+    std::size_t i = m_pos + m_scan;
+    while (i < m_buffer.size()) {
+        char c = m_buffer[i];
+        if (!isDigit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') break;
+        ++i;
+    }
+    if (i == m_buffer.size() && !m_finished) {
+        // The number may go on in the next chunk
+        m_scan = i - m_pos;
+        return needMore();
+    }
+
+    m_text.assign(m_buffer, m_pos, i - m_pos);
+    if (!isNumber(m_text)) return fail("malformed number '" + m_text + "'");
+    m_pos = i;
+    m_scan = 0;
+    return finishValue(Token::Number);
+}
+
+JsonPullParser::Token JsonPullParser::readLiteral(const char* word, Token token)
+{
+    std::size_t length = std::strlen(word);
+    std::size_t available = std::min(length, m_buffer.size() - m_pos);
+    if (m_buffer.compare(m_pos, available, word, available) != 0) {
+        return fail(std::string("expected '") + word + "'");
+    }
+    if (available < length) return needMore();
+
+    m_boolean = word[0] == 't';
+    m_pos += length;
+    return finishValue(token);
+}
+
+JsonPullParser::Token JsonPullParser::needMore()
+{
+    if (m_finished) return fail("unexpected end of input");
+    if (m_buffer.size() - m_pos > m_maxTokenSize) return fail("token too large");
+    return Token::NeedMore;
+}
+
+bool JsonPullParser::decodeString(std::size_t begin, std::size_t end)
+{
+    m_text.clear();
+    m_text.reserve(end - begin);
+    std::size_t i = begin;
+    while (i < end) {
+        char c = m_buffer[i];
+        if (static_cast<unsigned char>(c) < 0x20) {
+            fail("control character in a string");
+            return false;
+        }
+        if (c != '\\') {
+            m_text.push_back(c);
+            ++i;
+            continue;
+        }
+
+        char escape = m_buffer[i + 1];
+        i += 2;
+        switch (escape) {
+        case '"': m_text.push_back('"'); break;
+        case '\\': m_text.push_back('\\'); break;
+        case '/': m_text.push_back('/'); break;
+        case 'b': m_text.push_back('\b'); break;
+        case 'f': m_text.push_back('\f'); break;
+        case 'n': m_text.push_back('\n'); break;
+        case 'r': m_text.push_back('\r'); break;
+        case 't': m_text.push_back('\t'); break;
+        case 'u': {
+            auto readUnit = [this, end](std::size_t at, std::uint32_t& unit) {
+                if (at + 4 > end) return false;
+                unit = 0;
+                for (std::size_t k = at; k < at + 4; ++k) {
+                    int digit = hexValue(m_buffer[k]);
+                    if (digit < 0) return false;
+                    unit = unit << 4 | static_cast<std::uint32_t>(digit);
+                }
+                return true;
+            };
+            std::uint32_t code = 0;
+            if (!readUnit(i, code)) {
+                fail("malformed \\u escape");
+                return false;
+            }
+            i += 4;
+            // A surrogate pair is one character; a lone surrogate becomes
+            // U+FFFD
+            std::uint32_t low = 0;
+            if (code >= 0xD800 && code <= 0xDBFF && i + 1 < end && m_buffer[i] == '\\'
+                && m_buffer[i + 1] == 'u' && readUnit(i + 2, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                i += 6;
+            } else if (code >= 0xD800 && code <= 0xDFFF) {
+                code = 0xFFFD;
+            }
+            putUtf8(m_text, code);
+            break;
+        }
+        default:
+            fail(std::string("unknown escape '\\") + escape + "'");
+            return false;
+        }
+    }
+    return true;
+}
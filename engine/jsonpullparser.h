@@ -0,0 +1,90 @@
+#ifndef JSONPULLPARSER_H
+#define JSONPULLPARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Incremental JSON tokenizer. Bytes are fed in as they arrive, in chunks of
+// any size, and tokens are pulled out one at a time; no document is built.
+//
+// next() returns NeedMore when the input so far ends inside a token, and
+// carries on from there after the next feed(). Only the bytes of the token
+// being read are kept, so memory is bounded by the largest single token
+// (see setMaxTokenSize()) and the nesting depth, not by the document.
+// Strings come out unescaped as UTF-8; numbers as their text.
+class JsonPullParser
+{
+public:
+    enum class Token {
+        NeedMore,    // feed more input, or finish()
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Key,         // text(): the key
+        String,      // text(): the value
+        Number,      // text(): as written; number() parses it
+        Bool,        // boolean()
+        Null,
+        End,         // the document is complete
+        Error        // errorString(); every later call returns Error too
+    };
+
+    JsonPullParser();
+
+    void feed(const char* data, std::size_t size);
+    void feed(const std::string& data);
+    // No more input follows; a token cut short by the end is an error
+    void finish();
+
+    Token next();
+    // After StartObject or StartArray: skips to the end of that container,
+    // so the next token is whatever follows it
+    void skipContainer();
+
+    const std::string& text() const;
+    double number() const;
+    bool boolean() const;
+    int depth() const; // containers open after the last token
+    const std::string& errorString() const;
+
+    void setMaxTokenSize(std::size_t bytes);
+    void setMaxDepth(int depth);
+
+private:
+    enum class State {
+        Value,       // a value
+        ValueOrEnd,  // after '['
+        Key,         // after ',' in an object
+        KeyOrEnd,    // after '{'
+        Colon,
+        CommaOrEnd,  // after a value in a container
+        Done         // after the root value
+    };
+
+    Token readToken();
+    Token fail(const std::string& message);
+    Token finishValue(Token token);
+    Token readString(Token token);
+    Token readNumber();
+    Token readLiteral(const char* word, Token token);
+    Token needMore();
+    bool decodeString(std::size_t begin, std::size_t end);
+
+    std::string m_buffer;
+    std::size_t m_pos;   // first unconsumed byte of m_buffer
+    std::size_t m_scan;  // how far the token at m_pos was already scanned
+    std::vector<char> m_stack; // '{' or '[' per open container
+    State m_state;
+    std::string m_text;
+    bool m_boolean;
+    bool m_finished;
+    bool m_failed;
+    int m_skipTo;        // depth a skipContainer() ends at, -1 when not skipping
+    std::string m_error;
+    std::size_t m_maxTokenSize;
+    int m_maxDepth;
+};
+
+#endif // JSONPULLPARSER_H
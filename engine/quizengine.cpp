@@ -0,0 +1,618 @@
+#include "quizengine.h"
+#include <algorithm>
+
+QuizEngine::QuizEngine(std::uint64_t seed)
+    : m_shownSince(0)
+    , m_isActive(false)
+    , m_isPaused(false)
+    , m_currentIndex(0)
+    , m_answeredCount(0)
+    , m_correctCount(0)
+    , m_currentDifficulty(Difficulty::Easy)
+    , m_consecutiveCorrect(0)
+    , m_consecutiveWrong(0)
+    , m_selectionStrategy(SelectionStrategyRegistry::instance().create(
+          SelectionStrategyRegistry::defaultStrategy()))
+    , m_rng(seed)
+{
+    resetMetrics();
+}
+
+void QuizEngine::seed(std::uint64_t seed)
+{
+    m_rng.seed(seed);
+}
+
+int QuizEngine::slotOf(Difficulty difficulty)
+{
+    return static_cast<int>(difficulty);
+}
+
+double QuizEngine::baseWeight(Difficulty difficulty)
+{
+    // Initialize weights using weighted random selection
+    switch (difficulty) {
+        case Difficulty::Easy: return 1.0;
+        case Difficulty::Medium: return 1.5;
+        case Difficulty::Hard: return 2.0;
+    }
+    return 1.0;
+}
+
+// ========== SESSION CONTROL ==========
+
+void QuizEngine::start(EngineBankPtr bank, std::uint64_t now)
+{
+    reset();
+    m_bank = std::move(bank);
+    m_attempts.assign(questionCount(), QuestionAttempt());
+
+    buildQuestionPriorityQueue();
+    m_isActive = true;
+    m_shownSince = now;
+}
+
+bool QuizEngine::extend(EngineBankPtr bank)
+{
+    // Counted from the attempts, as a bank grown in place already has
+    // the new questions
+    int count = static_cast<int>(m_attempts.size());
+    if (!m_isActive || !bank || static_cast<int>(bank->size()) < count) return false;
+    m_bank = std::move(bank);
+
+    // Each new question is appended to its bucket's sampler (O(log n)
+    // each), and a bucket that had run out of questions is queued again;
+    // nothing already built is rebuilt
+    int total = questionCount();
+    m_attempts.resize(total);
+    m_bucketSlot.resize(total);
+    for (int i = count; i < total; ++i) {
+        Difficulty diff = (*m_bank)[i].difficulty;
+        DifficultyBucket& bucket = m_buckets[slotOf(diff)];
+        m_bucketSlot[i] = static_cast<int>(bucket.questions.size());
+        bucket.questions.push_back(i);
+        bucket.sampler.append(baseWeight(diff));
+        if (!m_bucketQueue.contains(slotOf(diff))) {
+            m_bucketQueue.push(slotOf(diff), timePriority(diff));
+        }
+    }
+
+    // Answered bitsets grow once per call, keeping their bits
+    for (DifficultyBucket& bucket : m_buckets) {
+        bucket.answered.resize(static_cast<int>(bucket.questions.size()));
+    }
+    return true;
+}
+
+void QuizEngine::finish(std::uint64_t now)
+{
+    recordDwell(now);
+    m_isActive = false;
+    m_isPaused = false;
+}
+
+void QuizEngine::reset()
+{
+    m_isActive = false;
+    m_isPaused = false;
+    m_currentIndex = 0;
+    m_answeredCount = 0;
+    m_correctCount = 0;
+    m_consecutiveCorrect = 0;
+    m_consecutiveWrong = 0;
+
+    m_bank.reset();
+    m_attempts.clear();
+    m_history.clear();
+    m_shownSince = 0;
+    m_bucketSlot.clear();
+    m_bucketQueue.clear();
+    for (DifficultyBucket& bucket : m_buckets) {
+        bucket.questions.clear();
+        bucket.sampler.clear();
+        bucket.answered.clear();
+        bucket.weightFactor = 1.0;
+    }
+
+    resetMetrics();
+}
+
+bool QuizEngine::pause(std::uint64_t now)
+{
+    if (!m_isActive || m_isPaused) return false;
+    recordDwell(now);
+    m_isPaused = true;
+    return true;
+}
+
+bool QuizEngine::resume(std::uint64_t now)
+{
+    if (!m_isActive || !m_isPaused) return false;
+    m_isPaused = false;
+    m_shownSince = now;
+    return true;
+}
+
+void QuizEngine::recordDwell(std::uint64_t now)
+{
+    // Close the running visit of the current question, if one is running
+    if (!m_isActive || m_isPaused || m_currentIndex >= static_cast<int>(m_attempts.size())) return;
+
+    if (now > m_shownSince) {
+        std::uint64_t total = m_attempts[m_currentIndex].timeSpentMs + (now - m_shownSince);
+        m_attempts[m_currentIndex].timeSpentMs = static_cast<std::uint32_t>(std::min<std::uint64_t>(total, UINT32_MAX));
+    }
+    m_shownSince = now;
+}
+
+bool QuizEngine::isActive() const
+{
+    return m_isActive;
+}
+
+bool QuizEngine::isPaused() const
+{
+    return m_isPaused;
+}
+
+// ========== NAVIGATION ==========
+
+bool QuizEngine::hasNext() const
+{
+    return m_selectionStrategy->hasNext(*this);
+}
+
+int QuizEngine::next(std::uint64_t now)
+{
+    if (!m_isActive || !hasNext()) return -1;
+
+    // Ask the selection strategy where to go; if it lands on the question
+    // already shown, step forward so Next always moves
+    int count = questionCount();
+    int next = m_selectionStrategy->selectNext(*this);
+    if (next == m_currentIndex || next < 0 || next >= count) {
+        next = m_currentIndex + 1 < count ? m_currentIndex + 1 : -1;
+    }
+    if (next == -1) return -1;
+
+    recordDwell(now);
+    m_history.push_back(m_currentIndex);
+    m_currentIndex = next;
+    return m_currentIndex;
+}
+
+int QuizEngine::previous(std::uint64_t now)
+{
+    if (!m_isActive || m_history.empty()) return -1;
+
+    recordDwell(now);
+    m_currentIndex = m_history.back();
+    m_history.pop_back();
+    return m_currentIndex;
+}
+
+int QuizEngine::goTo(int index, std::uint64_t now)
+{
+    if (!m_isActive || index < 0 || index >= questionCount()) return -1;
+
+    recordDwell(now);
+    m_currentIndex = index;
+    return m_currentIndex;
+}
+
+// ========== ANSWERING ==========
+
+AnswerResult QuizEngine::answer(int optionIndex, std::uint64_t now)
+{
+    AnswerResult result;
+    if (!m_isActive || m_currentIndex >= questionCount()) return result;
+
+    recordDwell(now);
+    const EngineQuestion& question = (*m_bank)[m_currentIndex];
+    QuestionAttempt& attempt = m_attempts[m_currentIndex];
+    attempt.answerIndex = static_cast<std::int8_t>(optionIndex);
+    attempt.answered = true;
+
+    bool isCorrect = optionIndex >= 0 && optionIndex == question.correctIndex;
+    Difficulty questionDifficulty = question.difficulty;
+
+    // Mark the question answered in its difficulty bitset (O(1)) and drop
+    // it from the weighted sampler so it is never drawn again; a bucket
+    // with nothing left leaves the time queue
+    DifficultyBucket& bucket = m_buckets[slotOf(questionDifficulty)];
+    bucket.answered.set(m_bucketSlot[m_currentIndex]);
+    bucket.sampler.remove(m_bucketSlot[m_currentIndex]);
+    if (bucket.sampler.isEmpty()) {
+        m_bucketQueue.remove(slotOf(questionDifficulty));
+    }
+
+    if (isCorrect) {
+        m_correctCount++;
+        m_consecutiveCorrect++;
+        m_consecutiveWrong = 0;
+    } else {
+        m_consecutiveWrong++;
+        m_consecutiveCorrect = 0;
+    }
+
+    m_answeredCount++;
+
+    // Update performance metrics, selection weights and difficulty
+    updatePerformanceMetrics(questionDifficulty, isCorrect, attempt.timeSpentMs / 1000.0);
+    updateQuestionWeights();
+
+    result.accepted = true;
+    result.correct = isCorrect;
+    result.difficultyChanged = updateDifficulty();
+    return result;
+}
+
+void QuizEngine::clearAnswer()
+{
+    if (!m_isActive || m_currentIndex >= questionCount()) return;
+
+    QuestionAttempt& attempt = m_attempts[m_currentIndex];
+    attempt.answerIndex = -1;
+    attempt.answered = false;
+}
+
+bool QuizEngine::updateDifficulty()
+{
+    Difficulty newDifficulty = m_currentDifficulty;
+
+    // Adaptive logic: 3 consecutive correct -> increase difficulty
+    if (m_consecutiveCorrect >= 3) {
+        switch (m_currentDifficulty) {
+            case Difficulty::Easy:
+                newDifficulty = Difficulty::Medium;
+                break;
+            case Difficulty::Medium:
+                newDifficulty = Difficulty::Hard;
+                break;
+            case Difficulty::Hard:
+                // Stay at hard
+                break;
+        }
+        m_consecutiveCorrect = 0; // Reset streak
+    }
+
+    // 3 consecutive wrong -> decrease difficulty
+    if (m_consecutiveWrong >= 3) {
+        switch (m_currentDifficulty) {
+            case Difficulty::Hard:
+                newDifficulty = Difficulty::Medium;
+                break;
+            case Difficulty::Medium:
+                newDifficulty = Difficulty::Easy;
+                break;
+            case Difficulty::Easy:
+                // Stay at easy
+                break;
+        }
+        m_consecutiveWrong = 0; // Reset streak
+    }
+
+    if (newDifficulty == m_currentDifficulty) return false;
+    m_currentDifficulty = newDifficulty;
+    return true;
+}
+
+// ========== STATE ==========
+
+const EngineBankPtr& QuizEngine::bank() const
+{
+    return m_bank;
+}
+
+const QuestionAttempt& QuizEngine::attempt(int index) const
+{
+    static const QuestionAttempt none;
+    if (index < 0 || index >= static_cast<int>(m_attempts.size())) return none;
+    return m_attempts[index];
+}
+
+bool QuizEngine::isAnswered(int index) const
+{
+    if (index < 0 || index >= static_cast<int>(m_bucketSlot.size())) return false;
+
+    const DifficultyBucket& bucket = m_buckets[slotOf((*m_bank)[index].difficulty)];
+    return bucket.answered.test(m_bucketSlot[index]);
+}
+
+double QuizEngine::effectiveWeight(int index) const
+{
+    if (index < 0 || index >= static_cast<int>(m_bucketSlot.size())) return 0.0;
+
+    const DifficultyBucket& bucket = m_buckets[slotOf((*m_bank)[index].difficulty)];
+    return bucket.sampler.weight(m_bucketSlot[index]) * bucket.weightFactor;
+}
+
+int QuizEngine::correctCount() const
+{
+    return m_correctCount;
+}
+
+std::uint32_t QuizEngine::timeSpentMs(int index, std::uint64_t now) const
+{
+    std::uint64_t total = attempt(index).timeSpentMs;
+    if (index == m_currentIndex && m_isActive && !m_isPaused && now > m_shownSince) {
+        total += now - m_shownSince;
+    }
+    return static_cast<std::uint32_t>(std::min<std::uint64_t>(total, UINT32_MAX));
+}
+
+// ========== ANALYTICS ==========
+
+int QuizEngine::attempts(Difficulty difficulty) const
+{
+    return m_attemptsByDifficulty[slotOf(difficulty)];
+}
+
+int QuizEngine::correct(Difficulty difficulty) const
+{
+    return m_correctByDifficulty[slotOf(difficulty)];
+}
+
+void QuizEngine::setAttempts(Difficulty difficulty, int count)
+{
+    m_attemptsByDifficulty[slotOf(difficulty)] = count;
+}
+
+double QuizEngine::overallAccuracy() const
+{
+    if (m_answeredCount == 0) return 0.0;
+    return static_cast<double>(m_correctCount) / m_answeredCount * 100.0;
+}
+
+double QuizEngine::averageTimePerQuestion() const
+{
+    std::uint64_t totalTime = 0;
+    int visited = 0;
+    for (const QuestionAttempt& attempt : m_attempts) {
+        if (attempt.timeSpentMs == 0) continue;
+        totalTime += attempt.timeSpentMs;
+        visited++;
+    }
+
+    if (visited == 0) return 0.0;
+    return static_cast<double>(totalTime) / visited / 1000.0;
+}
+
+// ========== SELECTION STRATEGY ==========
+
+bool QuizEngine::setSelectionStrategy(const std::string& name)
+{
+    std::unique_ptr<SelectionStrategy> strategy =
+        SelectionStrategyRegistry::instance().create(name);
+    if (!strategy) return false;
+
+    m_selectionStrategy = std::move(strategy);
+    return true;
+}
+
+std::string QuizEngine::selectionStrategy() const
+{
+    return m_selectionStrategy->name();
+}
+
+// ========== SELECTION CONTEXT ==========
+
+int QuizEngine::questionCount() const
+{
+    return m_bank ? static_cast<int>(m_bank->size()) : 0;
+}
+
+int QuizEngine::answeredCount() const
+{
+    return m_answeredCount;
+}
+
+int QuizEngine::currentQuestionIndex() const
+{
+    return m_currentIndex;
+}
+
+Difficulty QuizEngine::currentDifficulty() const
+{
+    return m_currentDifficulty;
+}
+
+int QuizEngine::consecutiveCorrect() const
+{
+    return m_consecutiveCorrect;
+}
+
+int QuizEngine::consecutiveWrong() const
+{
+    return m_consecutiveWrong;
+}
+
+double QuizEngine::accuracy(Difficulty difficulty) const
+{
+    return m_accuracyByDifficulty[slotOf(difficulty)];
+}
+
+double QuizEngine::averageTime(Difficulty difficulty) const
+{
+    return m_averageTimeByDifficulty[slotOf(difficulty)];
+}
+
+int QuizEngine::firstUnanswered(Difficulty difficulty) const
+{
+    const DifficultyBucket& bucket = m_buckets[slotOf(difficulty)];
+    if (bucket.questions.empty()) return -1;
+
+    int slot = bucket.answered.findFirstUnset();
+    return slot == -1 ? -1 : bucket.questions[slot];
+}
+
+int QuizEngine::sampleByWeight()
+{
+    // Algorithm: Weighted Random Selection using Fenwick trees (O(log n))
+
+    // Effective bucket weight is factor * sum of base weights, so picking a
+    // bucket by that and then a question by base weight gives every
+    // question probability base * factor / total
+    std::array<double, DifficultyCount> bucketWeights;
+    double totalWeight = 0.0;
+    for (int i = 0; i < DifficultyCount; ++i) {
+        bucketWeights[i] = m_buckets[i].weightFactor * m_buckets[i].sampler.totalWeight();
+        totalWeight += bucketWeights[i];
+    }
+
+    if (totalWeight <= 0.0) return -1;
+
+    double randomValue = std::uniform_real_distribution<double>(0.0, totalWeight)(m_rng);
+    const DifficultyBucket* lastBucket = nullptr;
+
+    for (int i = 0; i < DifficultyCount; ++i) {
+        if (bucketWeights[i] <= 0.0) continue;
+
+        const DifficultyBucket& bucket = m_buckets[i];
+        lastBucket = &bucket;
+        if (randomValue < bucketWeights[i]) {
+            int slot = bucket.sampler.sample(randomValue / bucket.weightFactor);
+            return slot == -1 ? -1 : bucket.questions[slot];
+        }
+        randomValue -= bucketWeights[i];
+    }
+
+    // Rounding pushed the draw past the last bucket
+    int slot = lastBucket->sampler.sample(lastBucket->sampler.totalWeight());
+    return slot == -1 ? -1 : lastBucket->questions[slot];
+}
+
+int QuizEngine::topTimePriority()
+{
+    // Algorithm: Time-Based Selection using Priority Queue
+
+    // Every question of a difficulty has the same time priority, so the
+    // heap holds one key per difficulty with questions left (O(1) top);
+    // within the winning difficulty the first unanswered question is taken
+    int slot = m_bucketQueue.top();
+    if (slot == -1) return -1;
+    const DifficultyBucket& bucket = m_buckets[slot];
+    int bucketSlot = bucket.answered.findFirstUnset();
+    return bucketSlot == -1 ? -1 : bucket.questions[bucketSlot];
+}
+
+void QuizEngine::updateQuestionWeights()
+{
+    // Update weights based on performance using Dynamic Programming approach
+    // The adjustment only depends on difficulty, so it is folded into the
+    // bucket factor (O(1)) instead of rewriting every unanswered weight.
+    // Answered questions have base weight 0 and are unaffected.
+    for (int i = 0; i < DifficultyCount; ++i) {
+        DifficultyBucket& bucket = m_buckets[i];
+        if (bucket.questions.empty()) continue;
+
+        // Performance-based weight adjustment
+        double accuracy = m_accuracyByDifficulty[i];
+        double avgTime = m_averageTimeByDifficulty[i];
+
+        // Adaptive weight calculation using exponential backoff
+        if (accuracy < 0.3) {
+            bucket.weightFactor *= 0.8; // Reduce weight for difficult questions
+        } else if (accuracy > 0.7) {
+            bucket.weightFactor *= 1.2; // Increase weight for easier questions
+        }
+
+        // Time-based adjustment
+        if (avgTime > 120) {
+            bucket.weightFactor *= 0.9; // Reduce weight for time-consuming questions
+        }
+    }
+
+    // The factors grow or shrink geometrically and would overflow after a
+    // few thousand answers. Only their ratios matter to selection, so they
+    // are scaled back together while they are still finite.
+    double largest = 0.0;
+    for (const DifficultyBucket& bucket : m_buckets) {
+        largest = std::max(largest, bucket.weightFactor);
+    }
+    if (largest > 1e100 || (largest > 0.0 && largest < 1e-100)) {
+        for (DifficultyBucket& bucket : m_buckets) {
+            bucket.weightFactor /= largest;
+        }
+    }
+}
+
+// ========== DSA ALGORITHMS FOR INTELLIGENT QUESTION SELECTION ==========
+
+void QuizEngine::resetMetrics()
+{
+    // Initial difficulty weights and performance tracking
+    m_difficultyWeights = {0.4, 0.4, 0.2};
+    m_accuracyByDifficulty = {0.5, 0.5, 0.5};
+    m_averageTimeByDifficulty = {60.0, 90.0, 120.0};
+    m_attemptsByDifficulty = {0, 0, 0};
+    m_correctByDifficulty = {0, 0, 0};
+    m_currentDifficulty = Difficulty::Easy;
+}
+
+void QuizEngine::buildQuestionPriorityQueue()
+{
+    int count = questionCount();
+    m_bucketQueue.reset(DifficultyCount);
+    m_bucketSlot.resize(count);
+
+    std::array<std::vector<double>, DifficultyCount> baseWeights;
+
+    // Categorize questions by difficulty (O(n))
+    for (int i = 0; i < count; ++i) {
+        Difficulty diff = (*m_bank)[i].difficulty;
+        DifficultyBucket& bucket = m_buckets[slotOf(diff)];
+        m_bucketSlot[i] = static_cast<int>(bucket.questions.size());
+        bucket.questions.push_back(i);
+        baseWeights[slotOf(diff)].push_back(baseWeight(diff));
+    }
+
+    // Fenwick tree and answered bitset per difficulty (O(n) build)
+    for (int i = 0; i < DifficultyCount; ++i) {
+        m_buckets[i].sampler.reset(baseWeights[i]);
+        m_buckets[i].answered.resize(static_cast<int>(m_buckets[i].questions.size()));
+        m_buckets[i].weightFactor = 1.0;
+    }
+
+    // One time priority key per difficulty that has questions
+    for (int i = 0; i < DifficultyCount; ++i) {
+        if (!m_buckets[i].questions.empty()) {
+            m_bucketQueue.push(i, timePriority(static_cast<Difficulty>(i)));
+        }
+    }
+}
+
+double QuizEngine::timePriority(Difficulty difficulty) const
+{
+    // Time-based priority calculation, combined with difficulty weight
+    double avgTime = m_averageTimeByDifficulty[slotOf(difficulty)];
+    double timePriority = 1.0 / (1.0 + avgTime / 60.0);
+    return timePriority * m_difficultyWeights[slotOf(difficulty)];
+}
+
+void QuizEngine::updatePerformanceMetrics(Difficulty difficulty, bool isCorrect, double timeSpent)
+{
+    int slot = slotOf(difficulty);
+    m_attemptsByDifficulty[slot]++;
+
+    if (isCorrect) {
+        m_correctByDifficulty[slot]++;
+    }
+
+    // Calculate accuracy by difficulty using rolling average
+    int attempts = m_attemptsByDifficulty[slot];
+    int correct = m_correctByDifficulty[slot];
+
+    if (attempts > 0) {
+        m_accuracyByDifficulty[slot] = static_cast<double>(correct) / attempts;
+    }
+
+    // Update average time by difficulty using exponential moving average
+    double alpha = 0.3; // Smoothing factor
+    m_averageTimeByDifficulty[slot] = alpha * timeSpent + (1 - alpha) * m_averageTimeByDifficulty[slot];
+
+    // The difficulty's time priority changed: one key update (O(log 3))
+    if (m_bucketQueue.contains(slot)) {
+        m_bucketQueue.update(slot, timePriority(difficulty));
+    }
+}
@@ -0,0 +1,191 @@
+#ifndef QUIZENGINE_H
+#define QUIZENGINE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "quiztypes.h"
+#include "weightedsampler.h"
+#include "indexbitset.h"
+#include "indexedheap.h"
+#include "selectionstrategy.h"
+
+// What the engine needs to know about a question. The text lives with the
+// caller; the engine only scores option indices.
+struct EngineQuestion {
+    Difficulty difficulty = Difficulty::Easy;
+    std::int8_t correctIndex = -1; // -1 if no option is correct
+};
+
+using EngineBank = std::vector<EngineQuestion>;
+using EngineBankPtr = std::shared_ptr<const EngineBank>;
+
+struct AnswerResult {
+    bool accepted = false;          // false if no quiz is running
+    bool correct = false;
+    bool difficultyChanged = false;
+};
+
+// Selection draws come from SplitMix64: eight bytes of state, where
+// std::mt19937_64 would add 2.5 KB to every session.
+class EngineRandom
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit EngineRandom(std::uint64_t seed = 0) : m_state(seed) {}
+    void seed(std::uint64_t seed) { m_state = seed; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    result_type operator()()
+    {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+// Headless quiz engine: session state, question selection, scoring and
+// adaptive difficulty in plain C++17. It has no clock and no event loop;
+// callers pass the current time in (milliseconds on any monotonic clock)
+// and react to the returned results, so one engine per simulated session
+// is cheap and can run on any thread.
+// Time spent on a question is its dwell time: the clock runs while the
+// question is shown and the quiz is not paused, and adds up across visits.
+// A bank is shared read-only between any number of engines.
+class QuizEngine : public SelectionContext
+{
+public:
+    explicit QuizEngine(std::uint64_t seed = std::random_device{}());
+    void seed(std::uint64_t seed);
+
+    // Session control
+    void start(EngineBankPtr bank, std::uint64_t now = 0);
+    // Grows the running session to bank, which must begin with the
+    // current bank. The new questions join selection as unanswered; all
+    // progress so far is kept. bank may be the current bank itself, grown
+    // in place by an owner no other engine shares it with.
+    bool extend(EngineBankPtr bank);
+    void finish(std::uint64_t now);
+    void reset();
+    bool pause(std::uint64_t now);
+    bool resume(std::uint64_t now);
+    bool isActive() const;
+    bool isPaused() const;
+
+    // Navigation. Each returns the new current index, or -1 if it did
+    // not move.
+    bool hasNext() const;
+    int next(std::uint64_t now);
+    int previous(std::uint64_t now);
+    int goTo(int index, std::uint64_t now);
+
+    // Answering, by option index (-1 for an answer that is not an option).
+    // The question's dwell time so far is its response time.
+    AnswerResult answer(int optionIndex, std::uint64_t now);
+    void clearAnswer();
+
+    // State
+    const EngineBankPtr& bank() const;
+    const QuestionAttempt& attempt(int index) const;
+    bool isAnswered(int index) const;
+    double effectiveWeight(int index) const;
+    int correctCount() const;
+    std::uint32_t timeSpentMs(int index, std::uint64_t now) const; // includes the running visit
+
+    // Analytics
+    int attempts(Difficulty difficulty) const;
+    int correct(Difficulty difficulty) const;
+    void setAttempts(Difficulty difficulty, int count);
+    double overallAccuracy() const;        // percent
+    double averageTimePerQuestion() const; // seconds, over visited questions
+
+    // Selection strategy, by registry name
+    bool setSelectionStrategy(const std::string& name);
+    std::string selectionStrategy() const;
+
+    // SelectionContext
+    int questionCount() const override;
+    int answeredCount() const override;
+    int currentQuestionIndex() const override;
+    Difficulty currentDifficulty() const override;
+    int consecutiveCorrect() const override;
+    int consecutiveWrong() const override;
+    double accuracy(Difficulty difficulty) const override;
+    double averageTime(Difficulty difficulty) const override;
+    int firstUnanswered(Difficulty difficulty) const override;
+    int sampleByWeight() override;
+    int topTimePriority() override;
+    void updateQuestionWeights() override;
+
+private:
+    static constexpr int DifficultyCount = 3;
+    static int slotOf(Difficulty difficulty);
+    static double baseWeight(Difficulty difficulty);
+
+    // Questions grouped by difficulty. Each bucket samples over the base
+    // weights of its questions; the per-difficulty performance adjustment
+    // is kept as one lazily applied factor, so the effective weight of a
+    // question is base weight * weightFactor.
+    // Answered state is a dense bitset per bucket, so the next unanswered
+    // question of a difficulty is found with count-trailing-zeros.
+    struct DifficultyBucket {
+        std::vector<int> questions; // question indices in this difficulty
+        WeightedSampler sampler;    // base weights, indexed by bucket slot
+        IndexBitset answered;       // answered flags, indexed by bucket slot
+        double weightFactor = 1.0;
+    };
+
+    void resetMetrics();
+    void buildQuestionPriorityQueue();
+    double timePriority(Difficulty difficulty) const;
+    void updatePerformanceMetrics(Difficulty difficulty, bool isCorrect, double timeSpent);
+    void recordDwell(std::uint64_t now);
+    bool updateDifficulty();
+
+    // Quiz State
+    EngineBankPtr m_bank;
+    std::vector<QuestionAttempt> m_attempts;
+    std::vector<int> m_history;
+    std::uint64_t m_shownSince; // when the current question's visit started
+    bool m_isActive;
+    bool m_isPaused;
+    int m_currentIndex;
+    int m_answeredCount;
+    int m_correctCount;
+
+    // Adaptive Logic
+    Difficulty m_currentDifficulty;
+    int m_consecutiveCorrect;
+    int m_consecutiveWrong;
+
+    // Priority Queue for time-based selection: indexed heap keyed by
+    // difficulty slot, holding each difficulty that has unanswered
+    // questions. Time priority only depends on difficulty, so an answer
+    // updates one key instead of every question of the difficulty; ties
+    // go to the easier difficulty.
+    IndexedHeap<4> m_bucketQueue;
+    std::array<DifficultyBucket, DifficultyCount> m_buckets;
+    std::vector<int> m_bucketSlot; // question index -> slot in its bucket
+    std::array<double, DifficultyCount> m_difficultyWeights;
+
+    // Performance tracking, indexed by difficulty
+    std::array<double, DifficultyCount> m_accuracyByDifficulty;
+    std::array<double, DifficultyCount> m_averageTimeByDifficulty;
+    std::array<int, DifficultyCount> m_attemptsByDifficulty;
+    std::array<int, DifficultyCount> m_correctByDifficulty;
+
+    std::unique_ptr<SelectionStrategy> m_selectionStrategy;
+    EngineRandom m_rng;
+};
+
+#endif // QUIZENGINE_H
@@ -0,0 +1,28 @@
+#ifndef QUIZTYPES_H
+#define QUIZTYPES_H
+
+#include <cstdint>
+
+// Types shared by the headless engine and the Qt application. Kept free of
+// Qt so the engine library builds and runs without it.
+
+enum class Difficulty {
+    Easy,
+    Medium,
+    Hard
+};
+
+enum class QuestionType {
+    MultipleChoice,
+    TrueFalse
+};
+
+// Per-session attempt state. Kept to 8 bytes so a session over a large
+// bank only holds a compact array of these next to the shared content.
+struct QuestionAttempt {
+    std::uint32_t timeSpentMs = 0; // dwell time over all visits, pauses excluded
+    std::int8_t answerIndex = -1;  // index into options, -1 if none
+    bool answered = false;
+};
+
+#endif // QUIZTYPES_H
@@ -0,0 +1,225 @@
+#include "selectionstrategy.h"
+
+namespace {
+
+const Difficulty kDifficulties[] = { Difficulty::Easy, Difficulty::Medium, Difficulty::Hard };
+
+// Moves through the questions in order, like a paper exam
+class SequentialStrategy : public SelectionStrategy
+{
+public:
+    std::string name() const override { return "sequential"; }
+
+    int selectNext(SelectionContext& context) override
+    {
+        int next = context.currentQuestionIndex() + 1;
+        return next < context.questionCount() ? next : -1;
+    }
+
+    bool hasNext(const SelectionContext& context) const override
+    {
+        return context.currentQuestionIndex() < context.questionCount() - 1;
+    }
+};
+
+// Algorithm: Weighted Random Selection using Fenwick trees (O(log n))
+class WeightedRandomStrategy : public SelectionStrategy
+{
+public:
+    std::string name() const override { return "weighted"; }
+
+    int selectNext(SelectionContext& context) override
+    {
+        return context.sampleByWeight();
+    }
+};
+
+// Algorithm: Difficulty-Based Selection using answered bitsets
+class DifficultyBasedStrategy : public SelectionStrategy
+{
+public:
+    std::string name() const override { return "difficulty"; }
+
+    int selectNext(SelectionContext& context) override
+    {
+        // Determine target difficulty based on performance
+        Difficulty targetDifficulty = context.currentDifficulty();
+
+        // Adaptive difficulty adjustment using sliding window
+        if (context.consecutiveCorrect() >= 3) {
+            // Increase difficulty
+            switch (targetDifficulty) {
+                case Difficulty::Easy: targetDifficulty = Difficulty::Medium; break;
+                case Difficulty::Medium: targetDifficulty = Difficulty::Hard; break;
+                case Difficulty::Hard: targetDifficulty = Difficulty::Hard; break;
+            }
+        } else if (context.consecutiveWrong() >= 2) {
+            // Decrease difficulty
+            switch (targetDifficulty) {
+                case Difficulty::Easy: targetDifficulty = Difficulty::Easy; break;
+                case Difficulty::Medium: targetDifficulty = Difficulty::Easy; break;
+                case Difficulty::Hard: targetDifficulty = Difficulty::Medium; break;
+            }
+        }
+
+        int questionIndex = context.firstUnanswered(targetDifficulty);
+        if (questionIndex != -1) return questionIndex;
+
+        // Fallback to weighted selection
+        return context.sampleByWeight();
+    }
+};
+
+// Algorithm: Adaptive Selection using Multi-Criteria Decision Making
+class AdaptiveStrategy : public SelectionStrategy
+{
+public:
+    std::string name() const override { return "adaptive"; }
+
+    int selectNext(SelectionContext& context) override
+    {
+        // Update weights based on current performance, then sample
+        context.updateQuestionWeights();
+        return context.sampleByWeight();
+    }
+};
+
+// Algorithm: Performance-Based Selection using Dynamic Programming
+class PerformanceBasedStrategy : public SelectionStrategy
+{
+public:
+    std::string name() const override { return "performance"; }
+
+    int selectNext(SelectionContext& context) override
+    {
+        // Select difficulty with best performance score
+        Difficulty bestDifficulty = Difficulty::Easy;
+        double bestScore = -1.0;
+
+        for (Difficulty diff : kDifficulties) {
+            double accuracy = context.accuracy(diff);
+            double avgTime = context.averageTime(diff);
+
+            // Performance score calculation using weighted average
+            double timeScore = 1.0 / (1.0 + avgTime / 60.0); // Normalize time
+            double performanceScore = 0.7 * accuracy + 0.3 * timeScore;
+            if (performanceScore > bestScore) {
+                bestScore = performanceScore;
+                bestDifficulty = diff;
+            }
+        }
+
+        int questionIndex = context.firstUnanswered(bestDifficulty);
+        if (questionIndex != -1) return questionIndex;
+
+        // Fallback
+        return context.sampleByWeight();
+    }
+};
+
+// Algorithm: Time-Based Selection using the indexed priority queue
+class TimeBasedStrategy : public SelectionStrategy
+{
+public:
+    std::string name() const override { return "time"; }
+
+    int selectNext(SelectionContext& context) override
+    {
+        return context.topTimePriority();
+    }
+};
+
+// Switches strategy as the quiz progresses: difficulty-based early on,
+// adaptive in the middle and performance-based towards the end
+class ProgressiveStrategy : public SelectionStrategy
+{
+public:
+    std::string name() const override { return "progressive"; }
+
+    int selectNext(SelectionContext& context) override
+    {
+        if (context.questionCount() == 0) return -1;
+
+        int progress = (context.answeredCount() * 100) / context.questionCount();
+        if (progress < 30) {
+            return m_difficulty.selectNext(context);
+        } else if (progress < 70) {
+            return m_adaptive.selectNext(context);
+        }
+        return m_performance.selectNext(context);
+    }
+
+private:
+    DifficultyBasedStrategy m_difficulty;
+    AdaptiveStrategy m_adaptive;
+    PerformanceBasedStrategy m_performance;
+};
+
+template <typename Strategy>
+SelectionStrategyRegistry::Factory factoryFor()
+{
+    return []() { return std::unique_ptr<SelectionStrategy>(new Strategy()); };
+}
+
+}
+
+bool SelectionStrategy::hasNext(const SelectionContext& context) const
+{
+    return context.answeredCount() < context.questionCount();
+}
+
+SelectionStrategyRegistry::SelectionStrategyRegistry()
+{
+    m_factories["sequential"] = factoryFor<SequentialStrategy>();
+    m_factories["weighted"] = factoryFor<WeightedRandomStrategy>();
+    m_factories["difficulty"] = factoryFor<DifficultyBasedStrategy>();
+    m_factories["adaptive"] = factoryFor<AdaptiveStrategy>();
+    m_factories["performance"] = factoryFor<PerformanceBasedStrategy>();
+    m_factories["time"] = factoryFor<TimeBasedStrategy>();
+    m_factories["progressive"] = factoryFor<ProgressiveStrategy>();
+}
+
+SelectionStrategyRegistry& SelectionStrategyRegistry::instance()
+{
+    static SelectionStrategyRegistry registry;
+    return registry;
+}
+
+void SelectionStrategyRegistry::registerStrategy(const std::string& name, Factory factory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_factories[name] = std::move(factory);
+}
+
+bool SelectionStrategyRegistry::contains(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_factories.count(name) > 0;
+}
+
+std::unique_ptr<SelectionStrategy> SelectionStrategyRegistry::create(const std::string& name) const
+{
+    Factory factory;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_factories.find(name);
+        if (it == m_factories.end()) return nullptr;
+        factory = it->second;
+    }
+    return factory();
+}
+
+std::vector<std::string> SelectionStrategyRegistry::names() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> result;
+    for (const auto& entry : m_factories) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+const char* SelectionStrategyRegistry::defaultStrategy()
+{
+    return "sequential";
+}
@@ -0,0 +1,71 @@
+#ifndef SELECTIONSTRATEGY_H
+#define SELECTIONSTRATEGY_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "quiztypes.h"
+
+// What a selection strategy can see and use of a running quiz. Implemented
+// by whatever owns the quiz state; strategies never touch it directly.
+class SelectionContext
+{
+public:
+    virtual ~SelectionContext() = default;
+
+    virtual int questionCount() const = 0;
+    virtual int answeredCount() const = 0;
+    virtual int currentQuestionIndex() const = 0;
+    virtual Difficulty currentDifficulty() const = 0;
+    virtual int consecutiveCorrect() const = 0;
+    virtual int consecutiveWrong() const = 0;
+
+    // Per-difficulty performance: accuracy in [0, 1], average time in seconds
+    virtual double accuracy(Difficulty difficulty) const = 0;
+    virtual double averageTime(Difficulty difficulty) const = 0;
+
+    // Selection primitives; all return a question index or -1
+    virtual int firstUnanswered(Difficulty difficulty) const = 0;
+    virtual int sampleByWeight() = 0;      // weighted random over unanswered
+    virtual int topTimePriority() = 0;     // best time-based candidate
+    virtual void updateQuestionWeights() = 0;
+};
+
+// Picks the question to move to when the user asks for the next one
+class SelectionStrategy
+{
+public:
+    virtual ~SelectionStrategy() = default;
+
+    virtual std::string name() const = 0;
+    virtual int selectNext(SelectionContext& context) = 0;
+    virtual bool hasNext(const SelectionContext& context) const;
+};
+
+// Process-wide table of strategy factories, looked up by name. The
+// built-in strategies are registered on first use.
+class SelectionStrategyRegistry
+{
+public:
+    using Factory = std::function<std::unique_ptr<SelectionStrategy>()>;
+
+    static SelectionStrategyRegistry& instance();
+
+    void registerStrategy(const std::string& name, Factory factory);
+    bool contains(const std::string& name) const;
+    std::unique_ptr<SelectionStrategy> create(const std::string& name) const;
+    std::vector<std::string> names() const;
+
+    static const char* defaultStrategy();
+
+private:
+    SelectionStrategyRegistry();
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Factory> m_factories;
+};
+
+#endif // SELECTIONSTRATEGY_H
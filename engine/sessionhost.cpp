@@ -0,0 +1,246 @@
+#include "sessionhost.h"
+#include <algorithm>
+
+SessionHost::SessionHost(EngineBankPtr bank, int threadCount)
+    : m_start(std::chrono::steady_clock::now())
+    , m_bank(std::move(bank))
+    , m_nextShard(0)
+{
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    m_shards.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        m_shards.push_back(std::make_unique<Shard>());
+    }
+    for (std::unique_ptr<Shard>& shard : m_shards) {
+        Shard* s = shard.get();
+        s->thread = std::thread([this, s]() { run(*s); });
+    }
+}
+
+SessionHost::~SessionHost()
+{
+    // Workers drain their queues before they exit
+    for (std::unique_ptr<Shard>& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->stopping = true;
+        shard->wake.notify_one();
+    }
+    for (std::unique_ptr<Shard>& shard : m_shards) {
+        shard->thread.join();
+    }
+}
+
+SessionHost::SessionId SessionHost::open(std::uint64_t seed, const std::string& strategy)
+{
+    // Spread sessions over the shards round-robin
+    int shardIndex = static_cast<int>(m_nextShard.fetch_add(1, std::memory_order_relaxed) % m_shards.size());
+    Shard& shard = *m_shards[shardIndex];
+    std::string name = strategy.empty() ? std::string(SelectionStrategyRegistry::defaultStrategy()) : strategy;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::uint32_t slotIndex;
+    if (!shard.freeSlots.empty()) {
+        slotIndex = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+    } else {
+        slotIndex = static_cast<std::uint32_t>(shard.slots.size());
+        shard.slots.emplace_back();
+    }
+
+    Slot& slot = shard.slots[slotIndex];
+    slot.open = true;
+    shard.openCount++;
+    SessionId id = makeId(shardIndex, slotIndex, slot.generation);
+
+    // The quiz is started by the shard's thread like any other work, ahead
+    // of whatever is posted for the session next
+    shard.tasks.push_back(Task{id, [this, seed, name](QuizEngine& engine) {
+        engine.seed(seed);
+        engine.setSelectionStrategy(name);
+        engine.start(m_bank, now());
+    }});
+    shard.wake.notify_one();
+    return id;
+}
+
+void SessionHost::close(SessionId id)
+{
+    enqueue(id, Work());
+}
+
+void SessionHost::post(SessionId id, Work work)
+{
+    if (!work) return;
+    enqueue(id, std::move(work));
+}
+
+void SessionHost::wait()
+{
+    for (std::unique_ptr<Shard>& shard : m_shards) {
+        std::unique_lock<std::mutex> lock(shard->mutex);
+        shard->idle.wait(lock, [&]() { return shard->tasks.empty() && !shard->running; });
+    }
+}
+
+SessionHost::TimerId SessionHost::scheduleDeadline(SessionId id, std::uint64_t deadline, Work work)
+{
+    int shardIndex;
+    std::uint32_t slot;
+    std::uint32_t generation;
+    if (!work || !decodeId(id, shardIndex, slot, generation)) return TimerWheel::InvalidTimer;
+
+    Shard& shard = *m_shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::uint64_t key = ++shard.nextDeadlineKey;
+    TimerId timer = shard.deadlines.schedule(deadline, key);
+    shard.deadlineTasks.emplace(key, Task{id, std::move(work)});
+
+    // The worker may be sleeping until a later deadline
+    shard.wake.notify_one();
+    return timer;
+}
+
+bool SessionHost::cancelDeadline(SessionId id, TimerId timer)
+{
+    int shardIndex;
+    std::uint32_t slot;
+    std::uint32_t generation;
+    if (!decodeId(id, shardIndex, slot, generation)) return false;
+
+    Shard& shard = *m_shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::uint64_t key = shard.deadlines.payload(timer);
+    if (!shard.deadlines.cancel(timer)) return false;
+    shard.deadlineTasks.erase(key);
+    return true;
+}
+
+std::uint64_t SessionHost::now() const
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+}
+
+const EngineBankPtr& SessionHost::bank() const
+{
+    return m_bank;
+}
+
+int SessionHost::threadCount() const
+{
+    return static_cast<int>(m_shards.size());
+}
+
+int SessionHost::sessionCount() const
+{
+    int count = 0;
+    for (const std::unique_ptr<Shard>& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        count += shard->openCount;
+    }
+    return count;
+}
+
+SessionHost::SessionId SessionHost::makeId(int shard, std::uint32_t slot, std::uint32_t generation) const
+{
+    // Low half: slot and shard interleaved; high half: slot generation, so
+    // an id of a closed session never matches the slot's next session
+    std::uint64_t index = static_cast<std::uint64_t>(slot) * m_shards.size() + shard;
+    return (static_cast<std::uint64_t>(generation) << 32) | index;
+}
+
+bool SessionHost::decodeId(SessionId id, int& shard, std::uint32_t& slot, std::uint32_t& generation) const
+{
+    std::uint32_t index = static_cast<std::uint32_t>(id);
+    generation = static_cast<std::uint32_t>(id >> 32);
+    shard = static_cast<int>(index % m_shards.size());
+    slot = static_cast<std::uint32_t>(index / m_shards.size());
+    return generation != 0;
+}
+
+void SessionHost::enqueue(SessionId id, Work work)
+{
+    int shardIndex;
+    std::uint32_t slot;
+    std::uint32_t generation;
+    if (!decodeId(id, shardIndex, slot, generation)) return;
+
+    Shard& shard = *m_shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.tasks.push_back(Task{id, std::move(work)});
+    shard.wake.notify_one();
+}
+
+void SessionHost::run(Shard& shard)
+{
+    std::vector<std::uint64_t> expired;
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    for (;;) {
+        // Due deadlines join the queue behind work already posted
+        if (!shard.deadlines.isEmpty()) {
+            expired.clear();
+            shard.deadlines.advance(now(), expired);
+            for (std::uint64_t key : expired) {
+                auto it = shard.deadlineTasks.find(key);
+                shard.tasks.push_back(std::move(it->second));
+                shard.deadlineTasks.erase(it);
+            }
+        }
+
+        if (shard.tasks.empty()) {
+            if (shard.stopping) return;
+
+            // Sleep until posted work, a new deadline or the next due one;
+            // every wakeup goes round the loop again
+            std::uint64_t next = shard.deadlines.nextDeadline();
+            if (next == UINT64_MAX) {
+                shard.wake.wait(lock);
+            } else {
+                shard.wake.wait_until(lock, m_start + std::chrono::milliseconds(next));
+            }
+            continue;
+        }
+
+        Task task = std::move(shard.tasks.front());
+        shard.tasks.pop_front();
+
+        int shardIndex;
+        std::uint32_t slotIndex;
+        std::uint32_t generation;
+        decodeId(task.id, shardIndex, slotIndex, generation);
+
+        // Work for a session that has since been closed is dropped
+        if (slotIndex < shard.slots.size()) {
+            Slot& slot = shard.slots[slotIndex];
+            if (slot.open && slot.generation == generation) {
+                if (task.work) {
+                    // The engine is only used on this thread, so it runs
+                    // unlocked; open() on other threads may grow the table
+                    // but never moves an engine. A new slot gets its engine
+                    // here, and its first task seeds it.
+                    if (!slot.engine) slot.engine = std::make_unique<QuizEngine>(0);
+                    QuizEngine* engine = slot.engine.get();
+                    shard.running = true;
+                    lock.unlock();
+                    task.work(*engine);
+                    lock.lock();
+                    shard.running = false;
+                } else {
+                    // Keep the engine for the next session in this slot
+                    slot.open = false;
+                    slot.engine->reset();
+                    if (++slot.generation == 0) slot.generation = 1;
+                    shard.freeSlots.push_back(slotIndex);
+                    shard.openCount--;
+                }
+            }
+        }
+
+        if (shard.tasks.empty()) {
+            shard.idle.notify_all();
+        }
+    }
+}
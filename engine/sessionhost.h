@@ -0,0 +1,103 @@
+#ifndef SESSIONHOST_H
+#define SESSIONHOST_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "quizengine.h"
+#include "timerwheel.h"
+
+// Runs many quiz sessions in one process over a single shared bank.
+//
+// Sessions live in a table split into one shard per worker thread. A
+// session belongs to the shard its id maps to, and all work for it runs on
+// that shard's thread, so an engine is only ever touched by one thread and
+// needs no locking of its own. Closed slots keep their engine and are
+// reused, so a busy host stops allocating once it reaches its peak size.
+// Each shard also keeps a timing wheel of session deadlines (quiz and
+// per-question limits) that its thread expires as it runs.
+class SessionHost
+{
+public:
+    using SessionId = std::uint64_t;
+    using Work = std::function<void(QuizEngine&)>;
+    using TimerId = TimerWheel::TimerId;
+
+    static constexpr SessionId InvalidSession = 0;
+
+    explicit SessionHost(EngineBankPtr bank, int threadCount = 0);
+    ~SessionHost();
+
+    SessionHost(const SessionHost&) = delete;
+    SessionHost& operator=(const SessionHost&) = delete;
+
+    // Opens a session and queues the start of its quiz on the shared bank;
+    // the quiz clock starts when the shard's thread runs it
+    SessionId open(std::uint64_t seed, const std::string& strategy = std::string());
+    // Closes the session once the work already posted for it has run
+    void close(SessionId id);
+    // Queues work for the session on its shard's thread; ignored if the
+    // session is closed by the time it runs
+    void post(SessionId id, Work work);
+    // Blocks until every posted piece of work has run
+    void wait();
+
+    // Runs work for the session once the host clock reaches deadline.
+    // Deadlines are in milliseconds of now().
+    TimerId scheduleDeadline(SessionId id, std::uint64_t deadline, Work work);
+    bool cancelDeadline(SessionId id, TimerId timer);
+    // Monotonic milliseconds since the host was created
+    std::uint64_t now() const;
+
+    const EngineBankPtr& bank() const;
+    int threadCount() const;
+    int sessionCount() const;
+
+private:
+    struct Slot {
+        std::unique_ptr<QuizEngine> engine;
+        std::uint32_t generation = 1;
+        bool open = false;
+    };
+
+    struct Task {
+        SessionId id;
+        Work work;   // empty for a close
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> freeSlots;
+        std::deque<Task> tasks;
+        TimerWheel deadlines;
+        std::unordered_map<std::uint64_t, Task> deadlineTasks; // by wheel payload
+        std::uint64_t nextDeadlineKey = 0;
+        int openCount = 0;
+        bool running = false; // a task is being run
+        bool stopping = false;
+        std::thread thread;
+    };
+
+    SessionId makeId(int shard, std::uint32_t slot, std::uint32_t generation) const;
+    bool decodeId(SessionId id, int& shard, std::uint32_t& slot, std::uint32_t& generation) const;
+    void enqueue(SessionId id, Work work);
+    void run(Shard& shard);
+
+    std::chrono::steady_clock::time_point m_start;
+    EngineBankPtr m_bank;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<std::uint32_t> m_nextShard;
+};
+
+#endif // SESSIONHOST_H
@@ -0,0 +1,410 @@
+#include "sessionjournal.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+const std::uint8_t JournalMagic[4] = {'Q', 'S', 'J', '1'};
+constexpr std::size_t FrameOverhead = 8; // length and CRC
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size)
+{
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> entries{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+        return entries;
+    }();
+
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void putFixed(std::vector<std::uint8_t>& out, std::uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void putSigned(std::vector<std::uint8_t>& out, std::int64_t value)
+{
+    putVarint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+void putString(std::vector<std::uint8_t>& out, const std::string& text)
+{
+    putVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+void putFrame(std::vector<std::uint8_t>& out, const std::vector<std::uint8_t>& payload)
+{
+    putFixed(out, payload.size(), 4);
+    out.insert(out.end(), payload.begin(), payload.end());
+    putFixed(out, crc32(payload.data(), payload.size()), 4);
+}
+
+// Bounds-checked cursor over a frame payload
+class Cursor
+{
+public:
+    Cursor(const std::uint8_t* data, std::size_t size) : m_data(data), m_size(size), m_pos(0) {}
+
+    bool atEnd() const { return m_pos == m_size; }
+
+    bool fixed(std::uint64_t& value, int bytes)
+    {
+        if (m_size - m_pos < static_cast<std::size_t>(bytes)) return false;
+        value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<std::uint64_t>(m_data[m_pos++]) << (8 * i);
+        }
+        return true;
+    }
+
+    bool varint(std::uint64_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_pos == m_size) return false;
+            std::uint8_t byte = m_data[m_pos++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool signedVarint(std::int64_t& value)
+    {
+        std::uint64_t raw;
+        if (!varint(raw)) return false;
+        value = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+        return true;
+    }
+
+    bool string(std::string& text)
+    {
+        std::uint64_t length;
+        return varint(length) && length <= m_size - m_pos
+            && bytes(text, static_cast<std::size_t>(length));
+    }
+
+    bool bytes(std::string& text, std::size_t length)
+    {
+        if (length > m_size - m_pos) return false;
+        text.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+        m_pos += length;
+        return true;
+    }
+
+private:
+    const std::uint8_t* m_data;
+    std::size_t m_size;
+    std::size_t m_pos;
+};
+
+bool carriesValue(SessionEventType type)
+{
+    return type == SessionEventType::Answer || type == SessionEventType::Next
+        || type == SessionEventType::Previous || type == SessionEventType::GoTo;
+}
+
+bool readStart(Cursor& cursor, SessionStart& start)
+{
+    std::uint64_t duration, limit, count;
+    if (!cursor.fixed(start.seed, 8) || !cursor.fixed(start.time, 8)
+        || !cursor.fixed(duration, 4) || !cursor.fixed(limit, 4)
+        || !cursor.string(start.strategy) || !cursor.varint(count)) {
+        return false;
+    }
+    start.quizDurationMs = static_cast<std::uint32_t>(duration);
+    start.questionLimitMs = static_cast<std::uint32_t>(limit);
+
+    std::string entries;
+    start.bank.clear();
+    return count <= SIZE_MAX / 2 && cursor.bytes(entries, static_cast<std::size_t>(count) * 2)
+        && decodeBankEntries(entries, start.bank)
+        && cursor.string(start.content) && cursor.atEnd();
+}
+
+bool readEvents(Cursor& cursor, std::uint64_t& time, std::vector<SessionEvent>& events)
+{
+    // Decoded into a scratch list so a bad frame adds nothing
+    std::vector<SessionEvent> batch;
+    std::uint64_t batchTime = time;
+    while (!cursor.atEnd()) {
+        SessionEvent event;
+        std::uint64_t type, delta;
+        if (!cursor.fixed(type, 1) || type < 1 || type > static_cast<std::uint64_t>(SessionEventType::Extend)
+            || !cursor.varint(delta)) {
+            return false;
+        }
+        event.type = static_cast<SessionEventType>(type);
+        batchTime += delta;
+        event.time = batchTime;
+
+        if (carriesValue(event.type)) {
+            std::int64_t value;
+            if (!cursor.signedVarint(value)) return false;
+            event.value = static_cast<std::int32_t>(value);
+        } else if (event.type == SessionEventType::Strategy && !cursor.string(event.text)) {
+            return false;
+        } else if (event.type == SessionEventType::Extend
+                   && (!cursor.string(event.text) || !cursor.string(event.content))) {
+            return false;
+        }
+        batch.push_back(std::move(event));
+    }
+
+    events.insert(events.end(), batch.begin(), batch.end());
+    time = batchTime;
+    return true;
+}
+
+} // namespace
+
+// ========== BANK ENTRIES ==========
+
+std::string encodeBankEntries(const EngineBank& bank, std::size_t from)
+{
+    // Two bytes per question: difficulty and correct option
+    std::string text;
+    for (std::size_t i = from; i < bank.size(); ++i) {
+        text.push_back(static_cast<char>(bank[i].difficulty));
+        text.push_back(static_cast<char>(bank[i].correctIndex));
+    }
+    return text;
+}
+
+bool decodeBankEntries(const std::string& text, EngineBank& bank)
+{
+    if (text.size() % 2 != 0) return false;
+    for (std::size_t i = 0; i < text.size(); i += 2) {
+        std::uint8_t difficulty = static_cast<std::uint8_t>(text[i]);
+        if (difficulty > 2) return false;
+        EngineQuestion question;
+        question.difficulty = static_cast<Difficulty>(difficulty);
+        question.correctIndex = static_cast<std::int8_t>(text[i + 1]);
+        bank.push_back(question);
+    }
+    return true;
+}
+
+// ========== WRITER ==========
+
+SessionJournalWriter::SessionJournalWriter()
+    : m_batchEvents(0)
+    , m_lastTime(0)
+{
+}
+
+void SessionJournalWriter::start(const SessionStart& start)
+{
+    m_out.assign(JournalMagic, JournalMagic + sizeof(JournalMagic));
+    m_batch.clear();
+    m_batchEvents = 0;
+    m_lastTime = start.time;
+
+    std::vector<std::uint8_t> payload;
+    putFixed(payload, start.seed, 8);
+    putFixed(payload, start.time, 8);
+    putFixed(payload, start.quizDurationMs, 4);
+    putFixed(payload, start.questionLimitMs, 4);
+    putString(payload, start.strategy);
+    putVarint(payload, start.bank.size());
+    std::string entries = encodeBankEntries(start.bank);
+    payload.insert(payload.end(), entries.begin(), entries.end());
+    putString(payload, start.content);
+    putFrame(m_out, payload);
+}
+
+void SessionJournalWriter::resume(std::uint64_t lastTime)
+{
+    m_out.clear();
+    m_batch.clear();
+    m_batchEvents = 0;
+    m_lastTime = lastTime;
+}
+
+void SessionJournalWriter::append(const SessionEvent& event)
+{
+    std::uint64_t time = event.time > m_lastTime ? event.time : m_lastTime;
+    m_batch.push_back(static_cast<std::uint8_t>(event.type));
+    putVarint(m_batch, time - m_lastTime);
+    if (carriesValue(event.type)) {
+        putSigned(m_batch, event.value);
+    } else if (event.type == SessionEventType::Strategy) {
+        putString(m_batch, event.text);
+    } else if (event.type == SessionEventType::Extend) {
+        putString(m_batch, event.text);
+        putString(m_batch, event.content);
+    }
+    m_lastTime = time;
+    ++m_batchEvents;
+}
+
+int SessionJournalWriter::pendingEvents() const
+{
+    return m_batchEvents;
+}
+
+bool SessionJournalWriter::hasPending() const
+{
+    return !m_out.empty() || m_batchEvents > 0;
+}
+
+std::vector<std::uint8_t> SessionJournalWriter::takePending()
+{
+    if (m_batchEvents > 0) {
+        putFrame(m_out, m_batch);
+        m_batch.clear();
+        m_batchEvents = 0;
+    }
+
+    std::vector<std::uint8_t> bytes;
+    bytes.swap(m_out);
+    return bytes;
+}
+
+// ========== READER ==========
+
+bool SessionJournalReader::read(const std::uint8_t* data, std::size_t size)
+{
+    m_start = SessionStart();
+    m_events.clear();
+    m_validSize = 0;
+
+    if (size < sizeof(JournalMagic)
+        || !std::equal(JournalMagic, JournalMagic + sizeof(JournalMagic), data)) {
+        return false;
+    }
+
+    std::size_t pos = sizeof(JournalMagic);
+    std::uint64_t time = 0;
+    bool started = false;
+    while (size - pos >= FrameOverhead) {
+        Cursor header(data + pos, 4);
+        std::uint64_t length;
+        header.fixed(length, 4);
+        if (length > size - pos - FrameOverhead) break;
+
+        const std::uint8_t* payload = data + pos + 4;
+        Cursor trailer(payload + length, 4);
+        std::uint64_t crc;
+        trailer.fixed(crc, 4);
+        if (crc != crc32(payload, static_cast<std::size_t>(length))) break;
+
+        Cursor cursor(payload, static_cast<std::size_t>(length));
+        if (!started) {
+            if (!readStart(cursor, m_start)) break;
+            time = m_start.time;
+            started = true;
+        } else if (!readEvents(cursor, time, m_events)) {
+            break;
+        }
+        pos += static_cast<std::size_t>(length) + FrameOverhead;
+        m_validSize = pos;
+    }
+
+    return started;
+}
+
+const SessionStart& SessionJournalReader::start() const
+{
+    return m_start;
+}
+
+const std::vector<SessionEvent>& SessionJournalReader::events() const
+{
+    return m_events;
+}
+
+std::size_t SessionJournalReader::validSize() const
+{
+    return m_validSize;
+}
+
+// ========== REPLAY ==========
+
+bool applySessionEvent(QuizEngine& engine, const SessionEvent& event)
+{
+    switch (event.type) {
+    case SessionEventType::Answer:
+        return engine.answer(event.value, event.time).accepted;
+    case SessionEventType::ClearAnswer:
+        engine.clearAnswer();
+        return true;
+    case SessionEventType::Next:
+        return engine.next(event.time) == event.value;
+    case SessionEventType::Previous:
+        return engine.previous(event.time) == event.value;
+    case SessionEventType::GoTo:
+        return engine.goTo(event.value, event.time) == event.value;
+    case SessionEventType::Pause:
+        return engine.pause(event.time);
+    case SessionEventType::Resume:
+        return engine.resume(event.time);
+    case SessionEventType::Finish:
+        engine.finish(event.time);
+        return true;
+    case SessionEventType::Strategy:
+        return engine.setSelectionStrategy(event.text);
+    case SessionEventType::Extend: {
+        if (!engine.bank()) return false;
+        auto bank = std::make_shared<EngineBank>(*engine.bank());
+        return decodeBankEntries(event.text, *bank) && engine.extend(std::move(bank));
+    }
+    }
+    return false;
+}
+
+SessionReplayState replaySession(QuizEngine& engine, const SessionStart& start,
+                                 EngineBankPtr bank,
+                                 const std::vector<SessionEvent>& events)
+{
+    SessionReplayState state;
+    engine.seed(start.seed);
+    if (!start.strategy.empty()) {
+        engine.setSelectionStrategy(start.strategy);
+    }
+    engine.start(std::move(bank), start.time);
+    state.lastTime = start.time;
+
+    for (const SessionEvent& event : events) {
+        bool running = engine.isActive() && !engine.isPaused();
+        if (!applySessionEvent(engine, event)) return state;
+
+        // Quiz and question clocks only run while the quiz is unpaused
+        if (running) {
+            state.activeMs += event.time - state.lastTime;
+            state.visitMs += event.time - state.lastTime;
+        }
+        if (event.type == SessionEventType::Next || event.type == SessionEventType::Previous
+            || event.type == SessionEventType::GoTo) {
+            state.visitMs = 0;
+        }
+        state.lastTime = event.time;
+        ++state.applied;
+    }
+
+    state.complete = true;
+    return state;
+}
@@ -0,0 +1,123 @@
+#ifndef SESSIONJOURNAL_H
+#define SESSIONJOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "quizengine.h"
+
+// Event-sourced record of one quiz session.
+//
+// A journal is a magic tag followed by frames: [u32 length][payload][u32
+// CRC-32], little endian. The first frame is the start record (seed,
+// strategy, bank, limits and an opaque content blob owned by the caller);
+// every later frame is a batch of events. An event is a type byte, the
+// milliseconds since the previous event as a varint and, for events that
+// carry one, a zigzag varint value, so a typical event takes 3 bytes.
+// Frames are only ever appended, and a torn or corrupt frame ends the
+// journal: everything before it is still good.
+//
+// Replaying the events on an engine seeded and started like the journaled
+// one rebuilds its state exactly, selection draws included, which also
+// makes a journal a deterministic input for benchmarks.
+enum class SessionEventType : std::uint8_t {
+    Answer = 1,   // value: option index
+    ClearAnswer,
+    Next,         // value: index moved to, or -1; journaled even when it does
+                  // not move, since selection may still have drawn
+    Previous,     // value: index moved to
+    GoTo,         // value: index moved to
+    Pause,
+    Resume,
+    Finish,
+    Strategy,     // text: strategy name
+    Extend        // text: bank entries of the questions added, content:
+                  // their caller-owned content, like the start record's
+};
+
+struct SessionEvent {
+    SessionEventType type = SessionEventType::Answer;
+    std::uint64_t time = 0; // engine clock, milliseconds
+    std::int32_t value = -1;
+    std::string text;
+    std::string content;
+};
+
+// Extend events carry bank entries in the start record's encoding
+std::string encodeBankEntries(const EngineBank& bank, std::size_t from = 0);
+bool decodeBankEntries(const std::string& text, EngineBank& bank);
+
+struct SessionStart {
+    std::uint64_t seed = 0;
+    std::uint64_t time = 0;
+    std::string strategy;
+    std::uint32_t quizDurationMs = 0;
+    std::uint32_t questionLimitMs = 0; // 0 for none
+    EngineBank bank;
+    std::string content; // question text, opaque to the engine
+};
+
+// Encodes a journal. Bytes accumulate in memory until the caller takes
+// them, so events written between two takes land in one frame.
+class SessionJournalWriter
+{
+public:
+    SessionJournalWriter();
+
+    // Begins a new journal: magic and start record
+    void start(const SessionStart& start);
+    // Continues an existing journal whose last event was at lastTime
+    void resume(std::uint64_t lastTime);
+    void append(const SessionEvent& event);
+
+    int pendingEvents() const;
+    bool hasPending() const;
+    // Closes the pending batch into a frame and returns everything not yet
+    // taken
+    std::vector<std::uint8_t> takePending();
+
+private:
+    std::vector<std::uint8_t> m_out;
+    std::vector<std::uint8_t> m_batch;
+    int m_batchEvents;
+    std::uint64_t m_lastTime;
+};
+
+// Decodes a journal, stopping at the first torn or corrupt frame
+class SessionJournalReader
+{
+public:
+    // False if there is no valid start record
+    bool read(const std::uint8_t* data, std::size_t size);
+
+    const SessionStart& start() const;
+    const std::vector<SessionEvent>& events() const;
+    // Bytes up to the end of the last good frame; appending resumes there
+    std::size_t validSize() const;
+
+private:
+    SessionStart m_start;
+    std::vector<SessionEvent> m_events;
+    std::size_t m_validSize = 0;
+};
+
+// Where a replay left the session, beyond what the engine itself holds
+struct SessionReplayState {
+    int applied = 0;            // events applied
+    bool complete = false;      // every event matched the engine
+    std::uint64_t lastTime = 0; // time of the last applied event
+    std::uint64_t activeMs = 0; // unpaused quiz time used
+    std::uint64_t visitMs = 0;  // unpaused time on the current visit
+};
+
+// Starts engine on bank as the journal did and applies events in order.
+// Stops at the first event the engine does not reproduce (a navigation
+// that lands elsewhere, an answer or pause it rejects).
+SessionReplayState replaySession(QuizEngine& engine, const SessionStart& start,
+                                 EngineBankPtr bank,
+                                 const std::vector<SessionEvent>& events);
+
+bool applySessionEvent(QuizEngine& engine, const SessionEvent& event);
+
+#endif // SESSIONJOURNAL_H
@@ -0,0 +1,97 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. A ring of slots with a head and a tail counter: the producer
+// only writes the tail and the consumer only writes the head, so each side
+// publishes with one release store and neither ever waits on the other.
+// Each side also caches the other's counter and only reloads it when the
+// ring looks full (or empty), which keeps the two counters' cache lines
+// from bouncing on every call.
+//
+//   tryPush  O(1)  false when the ring is full
+//   tryPop   O(1)  false when the ring is empty
+//
+// The capacity is rounded up to a power of two.
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : m_capacity(roundUp(capacity))
+        , m_mask(m_capacity - 1)
+        , m_slots(new T[m_capacity])
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return m_capacity; }
+
+    // Producer side
+    bool tryPush(T value)
+    {
+        std::size_t tail = m_tail.value.load(std::memory_order_relaxed);
+        if (tail - m_headCache >= m_capacity) {
+            m_headCache = m_head.value.load(std::memory_order_acquire);
+            if (tail - m_headCache >= m_capacity) return false;
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool tryPop(T& value)
+    {
+        std::size_t head = m_head.value.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.value.load(std::memory_order_acquire);
+            if (head == m_tailCache) return false;
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = T(); // releases what the slot held now
+        m_head.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate from either side while the other one runs
+    std::size_t size() const
+    {
+        std::size_t head = m_head.value.load(std::memory_order_acquire);
+        std::size_t tail = m_tail.value.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+private:
+    static constexpr std::size_t CacheLine = 64;
+
+    // Each counter on a cache line of its own
+    struct alignas(CacheLine) Counter {
+        std::atomic<std::size_t> value{0};
+    };
+
+    static std::size_t roundUp(std::size_t capacity)
+    {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<T[]> m_slots;
+
+    Counter m_head;                                // next slot to pop
+    alignas(CacheLine) std::size_t m_tailCache = 0; // consumer's view of m_tail
+    Counter m_tail;                                // next slot to push
+    alignas(CacheLine) std::size_t m_headCache = 0; // producer's view of m_head
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,274 @@
+#include "timerwheel.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+int lowestSetBit(std::uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+int highestSetBit(std::uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
+
+std::uint64_t rotateLeft(std::uint64_t word, int shift)
+{
+    shift &= 63;
+    return shift == 0 ? word : (word << shift) | (word >> (64 - shift));
+}
+
+} // namespace
+
+TimerWheel::TimerWheel(std::uint64_t now)
+    : m_now(now)
+    , m_size(0)
+{
+    m_heads.fill(NoNode);
+    m_occupied.fill(0);
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::uint64_t deadline, std::uint64_t payload)
+{
+    std::uint32_t node;
+    if (!m_free.empty()) {
+        node = m_free.back();
+        m_free.pop_back();
+    } else {
+        node = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    m_nodes[node].deadline = deadline;
+    m_nodes[node].payload = payload;
+    place(node);
+    m_size++;
+    return makeId(node);
+}
+
+bool TimerWheel::cancel(TimerId id)
+{
+    std::uint32_t node = nodeOf(id);
+    if (node == NoNode) return false;
+
+    unlink(node);
+    release(node);
+    return true;
+}
+
+void TimerWheel::clear()
+{
+    for (std::uint32_t node = 0; node < m_nodes.size(); ++node) {
+        if (m_nodes[node].list != FreeList) {
+            release(node);
+        }
+    }
+    m_heads.fill(NoNode);
+    m_occupied.fill(0);
+}
+
+bool TimerWheel::isPending(TimerId id) const
+{
+    return nodeOf(id) != NoNode;
+}
+
+std::uint64_t TimerWheel::deadline(TimerId id) const
+{
+    std::uint32_t node = nodeOf(id);
+    return node == NoNode ? 0 : m_nodes[node].deadline;
+}
+
+std::uint64_t TimerWheel::payload(TimerId id) const
+{
+    std::uint32_t node = nodeOf(id);
+    return node == NoNode ? 0 : m_nodes[node].payload;
+}
+
+int TimerWheel::size() const
+{
+    return m_size;
+}
+
+bool TimerWheel::isEmpty() const
+{
+    return m_size == 0;
+}
+
+std::uint64_t TimerWheel::now() const
+{
+    return m_now;
+}
+
+std::uint64_t TimerWheel::nextDeadline() const
+{
+    if (m_heads[DueList] != NoNode) return m_now;
+
+    // Every timer in a level is later than every timer in the levels below
+    // it, and within a level occupied slots are all ahead of now, so the
+    // lowest occupied slot of the lowest occupied level holds the earliest
+    for (int level = 0; level < LevelCount; ++level) {
+        if (!m_occupied[level]) continue;
+
+        int slot = lowestSetBit(m_occupied[level]);
+        std::uint64_t earliest = UINT64_MAX;
+        for (std::uint32_t node = m_heads[level * SlotCount + slot]; node != NoNode; node = m_nodes[node].next) {
+            earliest = std::min(earliest, m_nodes[node].deadline);
+        }
+        return earliest;
+    }
+
+    std::uint64_t earliest = UINT64_MAX;
+    for (std::uint32_t node = m_heads[OverflowList]; node != NoNode; node = m_nodes[node].next) {
+        earliest = std::min(earliest, m_nodes[node].deadline);
+    }
+    return earliest;
+}
+
+void TimerWheel::advance(std::uint64_t now, std::vector<std::uint64_t>& expired)
+{
+    if (now < m_now) now = m_now;
+    m_pending.clear();
+
+    auto take = [this](std::uint32_t list) {
+        for (std::uint32_t node = m_heads[list]; node != NoNode; node = m_nodes[node].next) {
+            m_pending.push_back(node);
+        }
+        m_heads[list] = NoNode;
+    };
+
+    take(DueList);
+    if ((now >> EpochBits) != (m_now >> EpochBits)) {
+        take(OverflowList);
+    }
+
+    // At each level, take the slots whose start time passed between the
+    // old and the new now. A level that did not move means none above it
+    // moved either.
+    for (int level = 0; level < LevelCount; ++level) {
+        int shift = level * LevelBits;
+        std::uint64_t elapsed = (now >> shift) - (m_now >> shift);
+        if (elapsed == 0) break;
+
+        std::uint64_t slots = ~std::uint64_t(0);
+        if (elapsed < SlotCount) {
+            int first = static_cast<int>(((m_now >> shift) + 1) & (SlotCount - 1));
+            slots = rotateLeft((std::uint64_t(1) << elapsed) - 1, first);
+        }
+        slots &= m_occupied[level];
+        m_occupied[level] &= ~slots;
+
+        while (slots) {
+            int slot = lowestSetBit(slots);
+            slots &= slots - 1;
+            take(level * SlotCount + slot);
+        }
+    }
+
+    m_now = now;
+
+    // Due timers fire; the rest cascade to the level matching the new now
+    for (std::uint32_t node : m_pending) {
+        if (m_nodes[node].deadline <= m_now) {
+            expired.push_back(m_nodes[node].payload);
+            release(node);
+        } else {
+            place(node);
+        }
+    }
+}
+
+TimerWheel::TimerId TimerWheel::makeId(std::uint32_t node) const
+{
+    return (static_cast<std::uint64_t>(m_nodes[node].generation) << 32) | node;
+}
+
+std::uint32_t TimerWheel::nodeOf(TimerId id) const
+{
+    std::uint32_t node = static_cast<std::uint32_t>(id);
+    std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+    if (node >= m_nodes.size()) return NoNode;
+
+    const Node& entry = m_nodes[node];
+    if (entry.list == FreeList || entry.generation != generation) return NoNode;
+    return node;
+}
+
+void TimerWheel::place(std::uint32_t node)
+{
+    std::uint64_t deadline = m_nodes[node].deadline;
+    if (deadline <= m_now) {
+        link(DueList, node);
+        return;
+    }
+
+    std::uint64_t differing = deadline ^ m_now;
+    if (differing >> EpochBits) {
+        link(OverflowList, node);
+        return;
+    }
+
+    int level = highestSetBit(differing) / LevelBits;
+    int slot = static_cast<int>((deadline >> (level * LevelBits)) & (SlotCount - 1));
+    link(level * SlotCount + slot, node);
+}
+
+void TimerWheel::link(std::uint32_t list, std::uint32_t node)
+{
+    Node& entry = m_nodes[node];
+    entry.list = list;
+    entry.prev = NoNode;
+    entry.next = m_heads[list];
+    if (entry.next != NoNode) {
+        m_nodes[entry.next].prev = node;
+    }
+    m_heads[list] = node;
+
+    if (list < DueList) {
+        m_occupied[list / SlotCount] |= std::uint64_t(1) << (list % SlotCount);
+    }
+}
+
+void TimerWheel::unlink(std::uint32_t node)
+{
+    Node& entry = m_nodes[node];
+    if (entry.prev != NoNode) {
+        m_nodes[entry.prev].next = entry.next;
+    } else {
+        m_heads[entry.list] = entry.next;
+    }
+    if (entry.next != NoNode) {
+        m_nodes[entry.next].prev = entry.prev;
+    }
+
+    if (entry.list < DueList && m_heads[entry.list] == NoNode) {
+        m_occupied[entry.list / SlotCount] &= ~(std::uint64_t(1) << (entry.list % SlotCount));
+    }
+}
+
+void TimerWheel::release(std::uint32_t node)
+{
+    Node& entry = m_nodes[node];
+    entry.list = FreeList;
+    entry.prev = NoNode;
+    entry.next = NoNode;
+    if (++entry.generation == 0) entry.generation = 1;
+    m_free.push_back(node);
+    m_size--;
+}
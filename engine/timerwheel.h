@@ -0,0 +1,82 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel for deadlines on a monotonic clock.
+//
+// Time is in caller-defined ticks (the application uses milliseconds).
+// Six levels of 64 slots cover 2^36 ticks; a timer sits in the level of
+// the highest 6-bit group where its deadline differs from now, and
+// cascades one level down each time that group is reached. Deadlines past
+// the current 2^36 epoch wait in an overflow list until it ends. Timers are
+// nodes of intrusive lists in a pool, so schedule and cancel are O(1), and
+// a per-level occupancy mask lets advance() skip empty slots. The wheel
+// has no clock of its own: callers pass the current time to advance().
+class TimerWheel
+{
+public:
+    using TimerId = std::uint64_t;
+
+    static constexpr TimerId InvalidTimer = 0;
+
+    explicit TimerWheel(std::uint64_t now = 0);
+
+    // Schedules payload to expire at deadline. A deadline that is already
+    // due expires on the next advance().
+    TimerId schedule(std::uint64_t deadline, std::uint64_t payload);
+    bool cancel(TimerId id);
+    void clear();
+
+    bool isPending(TimerId id) const;
+    std::uint64_t deadline(TimerId id) const; // 0 if not pending
+    std::uint64_t payload(TimerId id) const;  // 0 if not pending
+    int size() const;
+    bool isEmpty() const;
+
+    std::uint64_t now() const;
+    // Earliest pending deadline, or UINT64_MAX if nothing is pending
+    std::uint64_t nextDeadline() const;
+
+    // Moves the wheel to now (earlier times are ignored) and appends the
+    // payloads of every timer due by then to expired
+    void advance(std::uint64_t now, std::vector<std::uint64_t>& expired);
+
+private:
+    static constexpr int LevelBits = 6;
+    static constexpr int SlotCount = 1 << LevelBits;
+    static constexpr int LevelCount = 6;
+    static constexpr int EpochBits = LevelBits * LevelCount;
+    static constexpr std::uint32_t NoNode = 0xffffffffu;
+    static constexpr std::uint32_t DueList = LevelCount * SlotCount; // already due
+    static constexpr std::uint32_t OverflowList = DueList + 1;        // past this epoch
+    static constexpr std::uint32_t FreeList = DueList + 2;
+
+    struct Node {
+        std::uint64_t deadline = 0;
+        std::uint64_t payload = 0;
+        std::uint32_t prev = NoNode;
+        std::uint32_t next = NoNode;
+        std::uint32_t list = FreeList;
+        std::uint32_t generation = 1;
+    };
+
+    TimerId makeId(std::uint32_t node) const;
+    std::uint32_t nodeOf(TimerId id) const; // NoNode if stale
+    void place(std::uint32_t node);
+    void link(std::uint32_t list, std::uint32_t node);
+    void unlink(std::uint32_t node);
+    void release(std::uint32_t node);
+
+    std::vector<Node> m_nodes;
+    std::vector<std::uint32_t> m_free;
+    std::array<std::uint32_t, FreeList> m_heads;      // per slot, plus due and overflow
+    std::array<std::uint64_t, LevelCount> m_occupied;  // non-empty slots per level
+    std::vector<std::uint32_t> m_pending;             // scratch for advance()
+    std::uint64_t m_now;
+    int m_size;
+};
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,161 @@
+#include "weightedsampler.h"
+
+WeightedSampler::WeightedSampler()
+    : m_activeCount(0)
+    , m_topBit(0)
+{
+}
+
+void WeightedSampler::reset(const std::vector<double>& weights)
+{
+    const int n = static_cast<int>(weights.size());
+    m_weights.assign(n, 0.0);
+    m_tree.assign(n + 1, 0.0);
+    m_activeCount = 0;
+
+    // Linear-time Fenwick construction: push each node into its parent
+    for (int i = 0; i < n; ++i) {
+        const double w = weights[i] > 0.0 ? weights[i] : 0.0;
+        m_weights[i] = w;
+        if (w > 0.0) m_activeCount++;
+        m_tree[i + 1] += w;
+        const int parent = (i + 1) + ((i + 1) & -(i + 1));
+        if (parent <= n) {
+            m_tree[parent] += m_tree[i + 1];
+        }
+    }
+
+    m_topBit = 1;
+    while (m_topBit * 2 <= n) m_topBit *= 2;
+    if (n == 0) m_topBit = 0;
+}
+
+void WeightedSampler::clear()
+{
+    reset(std::vector<double>());
+}
+
+int WeightedSampler::size() const
+{
+    return static_cast<int>(m_weights.size());
+}
+
+int WeightedSampler::activeCount() const
+{
+    return m_activeCount;
+}
+
+bool WeightedSampler::isEmpty() const
+{
+    return m_activeCount == 0;
+}
+
+double WeightedSampler::weight(int index) const
+{
+    if (index < 0 || index >= size()) return 0.0;
+    return m_weights[index];
+}
+
+const std::vector<double>& WeightedSampler::weights() const
+{
+    return m_weights;
+}
+
+bool WeightedSampler::isRemoved(int index) const
+{
+    return weight(index) <= 0.0;
+}
+
+double WeightedSampler::totalWeight() const
+{
+    return prefixSum(size());
+}
+
+void WeightedSampler::setWeight(int index, double weight)
+{
+    if (index < 0 || index >= size()) return;
+    if (weight < 0.0) weight = 0.0;
+
+    const double old = m_weights[index];
+    if (old > 0.0 && weight <= 0.0) m_activeCount--;
+    if (old <= 0.0 && weight > 0.0) m_activeCount++;
+
+    m_weights[index] = weight;
+    add(index, weight - old);
+}
+
+void WeightedSampler::remove(int index)
+{
+    setWeight(index, 0.0);
+}
+
+void WeightedSampler::append(double weight)
+{
+    const double w = weight > 0.0 ? weight : 0.0;
+    if (w > 0.0) m_activeCount++;
+
+    // The new node covers itself and the lowbit - 1 items before it, whose
+    // sum comes from two prefix sums over the existing tree
+    if (m_tree.empty()) m_tree.push_back(0.0); // unused slot 0
+    const int index = size() + 1;
+    const double covered = prefixSum(index - 1) - prefixSum(index - (index & -index));
+    m_weights.push_back(w);
+    m_tree.push_back(w + covered);
+
+    if (m_topBit == 0) m_topBit = 1;
+    while (m_topBit * 2 <= index) m_topBit *= 2;
+}
+
+int WeightedSampler::sample(double value) const
+{
+    if (m_activeCount == 0) return -1;
+    if (value < 0.0) value = 0.0;
+
+    const int found = descend(value);
+    if (found < size() && m_weights[found] > 0.0) return found;
+
+    // Rounding left over from earlier updates can put value past the total
+    // or inside a removed item's empty range; take the nearest active item
+    const int n = size();
+    const int start = found < n ? found : n - 1;
+    for (int distance = 0; distance < n; ++distance) {
+        const int below = start - distance;
+        const int above = start + distance;
+        if (below < 0 && above >= n) break;
+        if (below >= 0 && m_weights[below] > 0.0) return below;
+        if (above < n && m_weights[above] > 0.0) return above;
+    }
+    return -1;
+}
+
+void WeightedSampler::add(int index, double delta)
+{
+    const int n = size();
+    for (int i = index + 1; i <= n; i += i & -i) {
+        m_tree[i] += delta;
+    }
+}
+
+double WeightedSampler::prefixSum(int count) const
+{
+    double sum = 0.0;
+    for (int i = count; i > 0; i -= i & -i) {
+        sum += m_tree[i];
+    }
+    return sum;
+}
+
+int WeightedSampler::descend(double value) const
+{
+    // Binary lifting: find the smallest index whose prefix sum exceeds value
+    const int n = size();
+    int pos = 0;
+    for (int step = m_topBit; step > 0; step >>= 1) {
+        const int next = pos + step;
+        if (next <= n && m_tree[next] <= value) {
+            pos = next;
+            value -= m_tree[next];
+        }
+    }
+    return pos; // 0-based index of the selected item
+}
@@ -0,0 +1,54 @@
+#ifndef WEIGHTEDSAMPLER_H
+#define WEIGHTEDSAMPLER_H
+
+#include <vector>
+
+// Weighted random sampling over a fixed set of items, backed by a Fenwick
+// (binary indexed) tree of the item weights.
+//
+//   reset      O(n)      build from a weight array
+//   sample     O(log n)  pick an item with probability weight / total
+//   setWeight  O(log n)  point update
+//   remove     O(log n)  point update to zero; the item is never sampled again
+//   append     O(log n)  add an item at the end
+//
+// An item with weight <= 0 counts as removed.
+class WeightedSampler
+{
+public:
+    WeightedSampler();
+
+    void reset(const std::vector<double>& weights);
+    void clear();
+
+    int size() const;
+    int activeCount() const;
+    bool isEmpty() const;
+
+    double weight(int index) const;
+    const std::vector<double>& weights() const;
+    bool isRemoved(int index) const;
+    double totalWeight() const;
+
+    void setWeight(int index, double weight);
+    void remove(int index);
+    void append(double weight);
+
+    // Returns the item whose cumulative weight range contains value, where
+    // value is in [0, totalWeight()). Never returns a removed item: if
+    // rounding lands value on one, the nearest active item is returned.
+    // Returns -1 if no item is active.
+    int sample(double value) const;
+
+private:
+    std::vector<double> m_tree;    // 1-based Fenwick tree
+    std::vector<double> m_weights; // raw weights, 0-based
+    int m_activeCount;
+    int m_topBit;                  // highest power of two <= size
+
+    void add(int index, double delta);
+    double prefixSum(int count) const;
+    int descend(double value) const;
+};
+
+#endif // WEIGHTEDSAMPLER_H
@@ -0,0 +1,588 @@
+#include "formatbenchmark.h"
+#include "apimanager.h"
+#include "questionpack.h"
+#include "responseparser.h"
+#include "builtinsources.h"
+#include "questionbank.h"
+#include "questionstream.h"
+#include "standinserver.h"
+#include "builtinbanks.h"
+#include <QTextStream>
+#include <QTemporaryDir>
+#include <QSaveFile>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThreadPool>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTimer>
+#include <QSet>
+#include <functional>
+#include <algorithm>
+#include <random>
+#if defined(Q_OS_MACOS)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+// Questions shaped like the bundled ones: a sentence of text, four short
+// options, half of them already answered
+QList<QuizQuestion> makeQuestions(int count)
+{
+    QList<QuizQuestion> questions;
+    questions.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QStringList options;
+        for (int option = 0; option < 4; ++option) {
+            options << QString("Option %1 for question number %2").arg(option + 1).arg(i);
+        }
+        QuizQuestion question(QString("What is the time complexity of operation %1 on a balanced binary search tree?").arg(i),
+                              options, options[i % 4], static_cast<Difficulty>(i % 3));
+        if (i % 2 == 0) {
+            question.setUserAnswer(options[(i / 2) % 4]);
+            question.setTimeSpentMs(1000 + (i * 37) % 60000);
+        }
+        questions.append(question);
+    }
+    return questions;
+}
+
+// Heap bytes the process has in use, or -1 where the allocator cannot say
+qint64 heapInUse()
+{
+#if defined(Q_OS_MACOS)
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return qint64(stats.size_in_use);
+#elif defined(__GLIBC__)
+    return qint64(mallinfo2().uordblks);
+#else
+    return -1;
+#endif
+}
+
+// A question as it was kept before content and attempt state were split:
+// every session built and held strings of its own
+struct LegacyQuestion {
+    QString question;
+    QStringList options;
+    QString correctAnswer;
+    Difficulty difficulty = Difficulty::Easy;
+    QuestionType type = QuestionType::MultipleChoice;
+    QString userAnswer;
+    bool answered = false;
+    int timeSpent = 0;
+};
+
+// A string with storage of its own, as the old banks built them
+QString freshCopy(const QString& text)
+{
+    return QString(text.constData(), text.size());
+}
+
+QStringList freshCopy(const QStringList& texts)
+{
+    QStringList copies;
+    for (const QString& text : texts) {
+        copies.append(freshCopy(text));
+    }
+    return copies;
+}
+
+// A built-in bank as ApiManager's initialize*() functions built it in
+// every constructor: each question with strings of its own
+QList<LegacyQuestion> legacyBank(BuiltinBankId id)
+{
+    const BuiltinBank& bank = builtinBank(id);
+    QList<LegacyQuestion> questions;
+    for (int i = 0; i < bank.count; ++i) {
+        const BuiltinQuestion& record = bank.questions[i];
+        LegacyQuestion legacy;
+        legacy.question = record.question.toString();
+        for (int option = 0; option < record.optionCount; ++option) {
+            legacy.options.append(record.options[option].toString());
+        }
+        if (record.correctIndex >= 0) {
+            legacy.correctAnswer = record.options[record.correctIndex].toString();
+        }
+        legacy.difficulty = record.difficulty;
+        legacy.type = record.type;
+        questions.append(legacy);
+    }
+    return questions;
+}
+
+// Heap blocks held by question lists, each shared block counted once.
+// Strings that point at literals are not mutable and hold none.
+class BlockCount
+{
+public:
+    void add(const void* block)
+    {
+        if (block) m_blocks.insert(block);
+    }
+    
+    void add(const QString& text)
+    {
+        if (text.data_ptr().isMutable()) add(text.constData());
+    }
+    
+    void add(const QStringList& texts)
+    {
+        if (texts.data_ptr().isMutable()) add(texts.constData());
+        for (const QString& text : texts) {
+            add(text);
+        }
+    }
+    
+    void add(const QList<LegacyQuestion>& questions)
+    {
+        if (questions.data_ptr().isMutable()) add(questions.constData());
+        for (const LegacyQuestion& question : questions) {
+            add(question.question);
+            add(question.options);
+            add(question.correctAnswer);
+        }
+    }
+    
+    void add(const QList<QuizQuestion>& questions)
+    {
+        if (questions.data_ptr().isMutable()) add(questions.constData());
+        for (const QuizQuestion& question : questions) {
+            const QuestionContentPtr& content = question.content();
+            add(content.data());
+            add(content->question);
+            add(content->options);
+            add(content->correctAnswer);
+        }
+    }
+    
+    int size() const
+    {
+        return m_blocks.size();
+    }
+    
+private:
+    QSet<const void*> m_blocks;
+};
+
+QString kilobytes(qint64 bytes)
+{
+    return bytes < 0 ? QString("n/a") : QString("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+}
+
+// A NewsAPI top-headlines response with count articles
+QByteArray makeArticlesResponse(int count)
+{
+    QJsonArray articles;
+    for (int i = 0; i < count; ++i) {
+        QJsonObject source;
+        source["id"] = QJsonValue();
+        source["name"] = QString("Source %1").arg(i % 50);
+        QJsonObject article;
+        article["source"] = source;
+        article["author"] = QString("Reporter %1").arg(i % 200);
+        article["title"] = QString("Headline number %1 about events that moved markets and politics today").arg(i);
+        article["description"] = QString("A longer summary of story %1, the kind of paragraph a news feed carries under each headline.").arg(i);
+        article["url"] = QString("https://news.example.com/story/%1").arg(i);
+        article["publishedAt"] = "2024-05-01T12:00:00Z";
+        articles.append(article);
+    }
+    QJsonObject response;
+    response["status"] = "ok";
+    response["totalResults"] = count;
+    response["articles"] = articles;
+    return QJsonDocument(response).toJson(QJsonDocument::Compact);
+}
+
+QString formatName(QuizFileFormat format)
+{
+    switch (format) {
+    case QuizFileFormat::Json: return "json";
+    case QuizFileFormat::Cbor: return "cbor";
+    case QuizFileFormat::Pack: return "qpk";
+    }
+    return QString();
+}
+
+// One streamed fetch: when its first question was in, and when the set a
+// quiz would start on was built from all of them
+struct FetchTiming {
+    double firstMs = -1.0;
+    double fullMs = -1.0;
+    int questions = 0;
+};
+
+FetchTiming timeStreamedFetch(const std::function<void(QSharedPointer<QuestionStream>)>& start, int count)
+{
+    FetchTiming timing;
+    auto stream = QSharedPointer<QuestionStream>::create(count);
+    QList<QuestionContentPtr> contents;
+    QElapsedTimer timer;
+    QEventLoop loop;
+    QObject::connect(stream.data(), &QuestionStream::questionsAvailable, &loop, [&]() {
+        contents += stream->takeAvailable();
+        if (timing.firstMs < 0 && !contents.isEmpty()) timing.firstMs = timer.nsecsElapsed() / 1e6;
+        if (!stream->isFinished()) return;
+        timing.questions = QuestionBank::makeSet("benchmark", contents)->questions().size();
+        timing.fullMs = timer.nsecsElapsed() / 1e6;
+        loop.quit();
+    });
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+    timer.start();
+    start(stream);
+    loop.exec();
+    return timing;
+}
+
+// "median / p95" of a sample, in milliseconds
+QString percentiles(QList<double> samples)
+{
+    if (samples.isEmpty()) return "n/a";
+    std::sort(samples.begin(), samples.end());
+    double median = samples[samples.size() / 2];
+    double p95 = samples[qMin<qsizetype>(samples.size() - 1, qsizetype(samples.size() * 0.95))];
+    return QString("%1 / %2 ms").arg(median, 0, 'f', 1).arg(p95, 0, 'f', 1);
+}
+
+}
+
+int runFormatBenchmark(QTextStream& out)
+{
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        out << "Cannot create a temporary directory" << Qt::endl;
+        return 1;
+    }
+    
+    out << QString("%1 %2 %3 %4 %5").arg("questions", 10).arg("format", 7)
+           .arg("save ms", 10).arg("load ms", 10).arg("size KB", 10) << Qt::endl;
+    
+    for (int count : {1000, 10000, 100000}) {
+        QList<QuizQuestion> questions = makeQuestions(count);
+        
+        for (QuizFileFormat format : {QuizFileFormat::Json, QuizFileFormat::Cbor, QuizFileFormat::Pack}) {
+            QString path = dir.filePath(QString("quiz%1.%2").arg(count).arg(formatName(format)));
+            
+            QElapsedTimer timer;
+            timer.start();
+            QSaveFile saveFile(path);
+            if (!saveFile.open(QIODevice::WriteOnly)
+                || !ApiManager::writeQuizFile(saveFile, "benchmark", questions, format)
+                || !saveFile.commit()) {
+                out << "Cannot write " << path << Qt::endl;
+                return 1;
+            }
+            double saveMs = timer.nsecsElapsed() / 1e6;
+            
+            timer.restart();
+            QFile loadFile(path);
+            loadFile.open(QIODevice::ReadOnly);
+            QList<QuizQuestion> loaded = ApiManager::readQuizFile(loadFile);
+            double loadMs = timer.nsecsElapsed() / 1e6;
+            
+            if (loaded.size() != questions.size() || loaded.last().getQuestion() != questions.last().getQuestion()) {
+                out << "Round trip failed for " << path << Qt::endl;
+                return 1;
+            }
+            
+            out << QString("%1 %2 %3 %4 %5").arg(count, 10)
+                   .arg(formatName(format), 7)
+                   .arg(saveMs, 10, 'f', 1).arg(loadMs, 10, 'f', 1)
+                   .arg(QFileInfo(path).size() / 1024.0, 10, 'f', 1) << Qt::endl;
+            
+            if (format == QuizFileFormat::Pack) {
+                // What starting a quiz from the pack costs: map it, build the
+                // engine bank and decode the first question
+                timer.restart();
+                QuestionPack pack;
+                bool opened = pack.open(path);
+                double openMs = timer.nsecsElapsed() / 1e6;
+                bool ready = opened && pack.engineBank() && pack.question(0);
+                double firstMs = timer.nsecsElapsed() / 1e6;
+                if (!ready) {
+                    out << "Cannot open " << path << Qt::endl;
+                    return 1;
+                }
+                out << QString("%1 %2 open %3 ms, first question %4 ms").arg("", 10).arg("", 7)
+                       .arg(openMs, 0, 'f', 3).arg(firstMs, 0, 'f', 3) << Qt::endl;
+            }
+        }
+    }
+    return 0;
+}
+
+int runStartupBenchmark(QTextStream& out)
+{
+    const int instances = 100;
+    bool haveHeap = heapInUse() >= 0;
+    QElapsedTimer timer;
+    
+    // Before: every ApiManager built both banks in its constructor
+    qint64 base = heapInUse();
+    timer.start();
+    {
+        QList<ApiManager*> managers;
+        QList<QList<LegacyQuestion>> banks;
+        for (int i = 0; i < instances; ++i) {
+            managers.append(new ApiManager);
+            banks.append(legacyBank(BuiltinBankId::Default));
+            banks.append(legacyBank(BuiltinBankId::CppDsa));
+        }
+        double perInstanceMs = timer.nsecsElapsed() / 1e6 / instances;
+        qint64 bytes = haveHeap ? (heapInUse() - base) / instances : -1;
+        BlockCount blocks;
+        for (const QList<LegacyQuestion>& bank : banks) {
+            blocks.add(bank);
+        }
+        out << QString("before: %1 ms per ApiManager, %2 heap, %3 bank allocations each")
+                   .arg(perInstanceMs, 0, 'f', 3).arg(kilobytes(bytes)).arg(blocks.size() / instances) << Qt::endl;
+        qDeleteAll(managers);
+    }
+    
+    // After: the first read builds each bank's shared content, once per
+    // process; every ApiManager after that only copies lists of pointers
+    base = heapInUse();
+    timer.restart();
+    ApiManager* first = new ApiManager;
+    QList<QuizQuestion> defaultBank = first->getDefaultQuestions();
+    QList<QuizQuestion> cppDsaBank = first->getCppDSAQuestions();
+    double firstMs = timer.nsecsElapsed() / 1e6;
+    qint64 firstBytes = haveHeap ? heapInUse() - base : -1;
+    BlockCount shared;
+    shared.add(defaultBank);
+    shared.add(cppDsaBank);
+    out << QString("after:  %1 ms for the first ApiManager and shared content, %2 heap, %3 bank allocations")
+               .arg(firstMs, 0, 'f', 3).arg(kilobytes(firstBytes)).arg(shared.size()) << Qt::endl;
+    
+    base = heapInUse();
+    timer.restart();
+    {
+        QList<ApiManager*> managers;
+        QList<QList<QuizQuestion>> banks;
+        for (int i = 0; i < instances; ++i) {
+            managers.append(new ApiManager);
+            banks.append(managers.last()->getDefaultQuestions());
+            banks.append(managers.last()->getCppDSAQuestions());
+        }
+        double perInstanceMs = timer.nsecsElapsed() / 1e6 / instances;
+        qint64 bytes = haveHeap ? (heapInUse() - base) / instances : -1;
+        BlockCount blocks = shared;
+        for (const QList<QuizQuestion>& bank : banks) {
+            blocks.add(bank);
+        }
+        out << QString("after:  %1 ms per later ApiManager, %2 heap, %3 bank allocations each")
+                   .arg(perInstanceMs, 0, 'f', 3).arg(kilobytes(bytes))
+                   .arg((blocks.size() - shared.size()) / instances) << Qt::endl;
+        qDeleteAll(managers);
+    }
+    
+    delete first;
+    return 0;
+}
+
+int runParseBenchmark(QTextStream& out)
+{
+    QThreadPool pool;
+    const int chunkSize = 16 * 1024;
+    for (int count : {1000, 10000, 100000}) {
+        QByteArray body = makeArticlesResponse(count);
+        
+        // Before: the whole body parsed on the GUI thread when it is in
+        QElapsedTimer timer;
+        timer.start();
+        std::mt19937 rng(1);
+        QList<QuizQuestion> questions;
+        const QJsonArray articles = QJsonDocument::fromJson(body).object()["articles"].toArray();
+        for (const QJsonValue& value : articles) {
+            QuizQuestion question;
+            if (NewsApiSource::questionFromArticle(value.toObject(), rng, question)) {
+                questions.append(question);
+            }
+        }
+        double inlineMs = timer.nsecsElapsed() / 1e6;
+        
+        // After: chunks handed to the pool as they would arrive; the GUI
+        // thread only copies them over
+        auto parser = QSharedPointer<ResponseParser>::create(&pool, "articles", &NewsApiSource::questionFromArticle);
+        double longestMs = 0.0;
+        for (qsizetype offset = 0; offset < body.size(); offset += chunkSize) {
+            timer.restart();
+            parser->feed(body.mid(offset, chunkSize));
+            qint64 elapsed = timer.nsecsElapsed();
+            parser->addCallerTime(elapsed);
+            longestMs = qMax(longestMs, elapsed / 1e6);
+        }
+        QEventLoop loop;
+        parser->finish(&loop, [&loop]() { loop.quit(); });
+        loop.exec();
+        
+        out << QString("%1 articles (%2 MB): inline %3 ms on the GUI thread; pool %4 ms on the GUI thread, longest stall %5 ms, %6 ms parsing on the pool, %7 questions")
+                   .arg(count)
+                   .arg(body.size() / 1e6, 0, 'f', 1)
+                   .arg(inlineMs, 0, 'f', 2)
+                   .arg(parser->callerMs(), 0, 'f', 2)
+                   .arg(longestMs, 0, 'f', 3)
+                   .arg(parser->parseMs(), 0, 'f', 2)
+                   .arg(parser->questions().size()) << Qt::endl;
+        if (parser->questions().size() != questions.size()) {
+            out << "pool parse disagrees with the inline parse" << Qt::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int runFetchBenchmark(QTextStream& out)
+{
+    StandInServer server;
+    if (!server.listen()) {
+        out << "stand-in server could not listen" << Qt::endl;
+        return 1;
+    }
+    
+    // Every provider pointed at the stand-in, with both caches off so each
+    // run goes over the socket
+    ApiManager manager;
+    manager.setCacheDirectory(QString());
+    for (const QString& name : manager.availableProviders()) {
+        QUrl url = server.providerUrl(name);
+        if (!url.isEmpty()) manager.configureProvider(name, {{"url", url}, {"key", "stand-in"}});
+    }
+    
+    struct Scenario {
+        const char* label;
+        int latencyMs;
+        int paddingBytes;
+        double errorRate;
+        int chunkBytes;
+        int chunkDelayMs;
+    };
+    const Scenario scenarios[] = {
+        {"no latency", 0, 0, 0.0, 0, 0},
+        {"100 ms latency", 100, 0, 0.0, 0, 0},
+        {"8 KB per element in 16 KB chunks, 5 ms apart", 20, 8 * 1024, 0.0, 16 * 1024, 5},
+        {"20% of requests failing", 50, 0, 0.2, 0, 0},
+    };
+    const int count = 20;
+    const int runs = 21;
+    for (const Scenario& scenario : scenarios) {
+        StandInServer::Config config;
+        config.latencyMs = scenario.latencyMs;
+        config.items = 50;
+        config.paddingBytes = scenario.paddingBytes;
+        config.errorRate = scenario.errorRate;
+        config.chunkBytes = scenario.chunkBytes;
+        config.chunkDelayMs = scenario.chunkDelayMs;
+        server.setConfig(config);
+        server.resetStats();
+        
+        QList<double> first, full, fanOutFirst, fanOutFull;
+        for (int run = 0; run < runs; ++run) {
+            FetchTiming single = timeStreamedFetch([&manager, count](QSharedPointer<QuestionStream> stream) {
+                manager.fetchQuestions(count, stream);
+            }, count);
+            if (single.firstMs >= 0) first.append(single.firstMs);
+            if (single.fullMs >= 0) full.append(single.fullMs);
+            
+            FetchTiming fanOut = timeStreamedFetch([&manager, count](QSharedPointer<QuestionStream> stream) {
+                manager.fetchFromProviders(count, stream);
+            }, count);
+            if (fanOut.firstMs >= 0) fanOutFirst.append(fanOut.firstMs);
+            if (fanOut.fullMs >= 0) fanOutFull.append(fanOut.fullMs);
+        }
+        
+        StandInServer::Stats stats = server.stats();
+        out << scenario.label << Qt::endl;
+        out << QString("  newsapi:  first question %1, full set %2")
+                   .arg(percentiles(first), percentiles(full)) << Qt::endl;
+        out << QString("  fan-out:  first question %1, full set %2")
+                   .arg(percentiles(fanOutFirst), percentiles(fanOutFull)) << Qt::endl;
+        out << QString("  server:   %1 requests, %2 served, %3 failed, %4 KB sent")
+                   .arg(stats.requests).arg(stats.served).arg(stats.errors)
+                   .arg(stats.bodyBytes / 1024) << Qt::endl;
+    }
+    return 0;
+}
+
+int runMemoryBenchmark(QTextStream& out)
+{
+    if (heapInUse() < 0) {
+        out << "heap statistics are not available on this platform" << Qt::endl;
+        return 1;
+    }
+    
+    const int sessions = 100;
+    out << QString("%1 %2 %3 %4 %5 %6").arg("questions", 10)
+           .arg("before B/q", 12).arg("before KB/s", 12)
+           .arg("content B/q", 12).arg("after B/q", 10).arg("after KB/s", 11) << Qt::endl;
+    
+    for (int count : {100, 1000, 10000}) {
+        const QList<QuizQuestion> source = makeQuestions(count);
+        
+        // Before: each session builds every question with its own strings
+        qint64 base = heapInUse();
+        qint64 beforeBytes = 0;
+        {
+            QList<QList<LegacyQuestion>> held;
+            for (int session = 0; session < sessions; ++session) {
+                QList<LegacyQuestion> questions;
+                questions.reserve(count);
+                for (const QuizQuestion& question : source) {
+                    LegacyQuestion legacy;
+                    legacy.question = freshCopy(question.getQuestion());
+                    legacy.options = freshCopy(question.getOptions());
+                    legacy.correctAnswer = freshCopy(question.getCorrectAnswer());
+                    legacy.difficulty = question.getDifficulty();
+                    legacy.type = question.getType();
+                    questions.append(legacy);
+                }
+                held.append(questions);
+            }
+            beforeBytes = heapInUse() - base;
+        }
+        
+        // After: content is built once per bank, and a session holds a
+        // handle and an attempt per question
+        base = heapInUse();
+        QList<QuestionContentPtr> contents;
+        contents.reserve(count);
+        for (const QuizQuestion& question : source) {
+            contents.append(QuizQuestion::makeContent(freshCopy(question.getQuestion()),
+                                                      freshCopy(question.getOptions()),
+                                                      freshCopy(question.getCorrectAnswer()),
+                                                      question.getDifficulty(), question.getType()));
+        }
+        qint64 contentBytes = heapInUse() - base;
+        
+        base = heapInUse();
+        qint64 afterBytes = 0;
+        {
+            QList<QList<QuizQuestion>> held;
+            for (int session = 0; session < sessions; ++session) {
+                QList<QuizQuestion> questions;
+                questions.reserve(count);
+                for (const QuestionContentPtr& content : contents) {
+                    questions.append(QuizQuestion(content));
+                }
+                held.append(questions);
+            }
+            afterBytes = heapInUse() - base;
+        }
+        
+        double perQuestion = double(sessions) * count;
+        out << QString("%1 %2 %3 %4 %5 %6").arg(count, 10)
+                   .arg(beforeBytes / perQuestion, 12, 'f', 1)
+                   .arg(beforeBytes / 1024.0 / sessions, 12, 'f', 1)
+                   .arg(double(contentBytes) / count, 12, 'f', 1)
+                   .arg(afterBytes / perQuestion, 10, 'f', 1)
+                   .arg(afterBytes / 1024.0 / sessions, 11, 'f', 1) << Qt::endl;
+    }
+    return 0;
+}
\ No newline at end of file
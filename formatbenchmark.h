@@ -0,0 +1,38 @@
+#ifndef FORMATBENCHMARK_H
+#define FORMATBENCHMARK_H
+
+class QTextStream;
+
+// Compares the custom quiz file formats: save time, load time and file
+// size for synthetic quizzes of 1k, 10k and 100k questions, written to a
+// temporary directory. Run with: QuizSystem --benchmark-formats
+int runFormatBenchmark(QTextStream& out);
+
+// Heap bytes per question and per session for banks of 100, 1k and 10k
+// questions, measured from the allocator over 100 sessions each: before,
+// with every session holding its own copy of each question's strings, and
+// after, with content built once per bank and shared by every session.
+// Run with: QuizSystem --benchmark-memory
+int runMemoryBenchmark(QTextStream& out);
+
+// Startup cost of the built-in banks per ApiManager, over 100 instances:
+// before, with each constructor building both banks from strings of its
+// own, and after, with the content built once per process and shared.
+// Prints time, heap bytes and the heap blocks the banks hold.
+// Run with: QuizSystem --benchmark-startup
+int runStartupBenchmark(QTextStream& out);
+
+// GUI thread cost of a provider response of 1k, 10k and 100k articles:
+// parsed whole on the GUI thread as fetches used to, against fed in 16 KB
+// chunks to a ResponseParser on the parse pool.
+// Run with: QuizSystem --benchmark-parse
+int runParseBenchmark(QTextStream& out);
+
+// Time to the first question and to a full set, median and p95, for a
+// streamed NewsAPI fetch and for a fan-out over every provider, against a
+// local StandInServer: no latency, added latency, large trickled bodies
+// and failing requests. Caches are off, so every run reaches the server.
+// Run with: QuizSystem --benchmark-fetch
+int runFetchBenchmark(QTextStream& out);
+
+#endif // FORMATBENCHMARK_H
\ No newline at end of file
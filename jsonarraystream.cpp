@@ -0,0 +1,159 @@
+#include "jsonarraystream.h"
+#include <QIODevice>
+
+JsonArrayStream::JsonArrayStream(const QString& arrayKey, ElementHandler handler)
+    : m_arrayKey(arrayKey)
+    , m_handler(std::move(handler))
+    , m_arrayDepth(arrayKey.isEmpty() ? 1 : 2)
+    , m_inArray(false)
+    , m_elements(0)
+    , m_stopped(false)
+    , m_finished(false)
+{
+}
+
+bool JsonArrayStream::feed(const QByteArray& bytes)
+{
+    if (m_stopped || hasError()) return false;
+    m_parser.feed(bytes.constData(), static_cast<std::size_t>(bytes.size()));
+    return pump();
+}
+
+bool JsonArrayStream::finish()
+{
+    if (m_stopped || hasError()) return false;
+    m_parser.finish();
+    return pump() && m_finished;
+}
+
+bool JsonArrayStream::readAll(QIODevice& device, qint64 chunkSize)
+{
+    while (!device.atEnd()) {
+        QByteArray bytes = device.read(chunkSize);
+        if (bytes.isEmpty()) break;
+        if (!feed(bytes)) return false;
+    }
+    return finish();
+}
+
+QJsonObject JsonArrayStream::fields() const
+{
+    return m_fields;
+}
+
+int JsonArrayStream::elementCount() const
+{
+    return m_elements;
+}
+
+bool JsonArrayStream::isStopped() const
+{
+    return m_stopped;
+}
+
+bool JsonArrayStream::hasError() const
+{
+    return !m_parser.errorString().empty();
+}
+
+QString JsonArrayStream::errorString() const
+{
+    return QString::fromStdString(m_parser.errorString());
+}
+
+bool JsonArrayStream::pump()
+{
+    using Token = JsonPullParser::Token;
+    while (!m_stopped) {
+        Token token = m_parser.next();
+        int depth = m_parser.depth();
+        const std::string& text = m_parser.text();
+        
+        switch (token) {
+        case Token::NeedMore:
+            return true;
+        case Token::End:
+            m_finished = true;
+            return true;
+        case Token::Error:
+            return false;
+        case Token::Key:
+            if (!m_frames.isEmpty()) {
+                m_frames.last().key = QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+            } else if (depth == 1) {
+                m_rootKey = QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+            }
+            break;
+        case Token::StartObject:
+        case Token::StartArray: {
+            bool isObject = token == Token::StartObject;
+            if (!m_frames.isEmpty() || (m_inArray && isObject && depth == m_arrayDepth + 1)) {
+                // Part of an element: built
+                Frame frame;
+                frame.isObject = isObject;
+                m_frames.append(frame);
+            } else if (!isObject && !m_inArray && depth == m_arrayDepth
+                       && (m_arrayKey.isEmpty() || m_rootKey == m_arrayKey)) {
+                m_inArray = true;
+            } else if (!(isObject && depth == 1 && !m_arrayKey.isEmpty())) {
+                // Anything else but the root object: never parsed into values
+                m_parser.skipContainer();
+            }
+            break;
+        }
+        case Token::EndObject:
+        case Token::EndArray:
+            if (!m_frames.isEmpty()) {
+                closeFrame();
+            } else if (m_inArray && depth == m_arrayDepth - 1) {
+                m_inArray = false;
+            }
+            break;
+        case Token::String:
+        case Token::Number:
+        case Token::Bool:
+        case Token::Null: {
+            QJsonValue value;
+            if (token == Token::String) {
+                value = QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+            } else if (token == Token::Number) {
+                value = m_parser.number();
+            } else if (token == Token::Bool) {
+                value = m_parser.boolean();
+            }
+            if (!m_frames.isEmpty()) {
+                addValue(value);
+            } else if (depth == 1 && !m_arrayKey.isEmpty()) {
+                m_fields.insert(m_rootKey, value);
+            }
+            break;
+        }
+        }
+    }
+    return false;
+}
+
+void JsonArrayStream::addValue(const QJsonValue& value)
+{
+    Frame& parent = m_frames.last();
+    if (parent.isObject) {
+        parent.object.insert(parent.key, value);
+    } else {
+        parent.array.append(value);
+    }
+}
+
+void JsonArrayStream::closeFrame()
+{
+    Frame frame = m_frames.takeLast();
+    if (!m_frames.isEmpty()) {
+        addValue(frame.isObject ? QJsonValue(frame.object) : QJsonValue(frame.array));
+        return;
+    }
+    
+    // A whole element
+    m_elements++;
+    if (!m_handler(frame.object)) {
+        m_stopped = true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef JSONARRAYSTREAM_H
+#define JSONARRAYSTREAM_H
+
+#include <QString>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QList>
+#include <functional>
+#include "jsonpullparser.h"
+
+class QIODevice;
+
+// Streams the objects of one array in a JSON document, such as "articles"
+// in {"status": "ok", "articles": [{...}, {...}]}, without building the
+// document. Bytes go in as they arrive; each element is handed over as a
+// QJsonObject as soon as its closing brace is read, so only one element is
+// ever held. Scalar fields of the root object are kept (see fields());
+// everything else outside the array is skipped unparsed.
+class JsonArrayStream
+{
+public:
+    // Called per element; returning false stops the stream
+    using ElementHandler = std::function<bool(const QJsonObject&)>;
+
+    // An empty arrayKey streams a document that is itself an array
+    JsonArrayStream(const QString& arrayKey, ElementHandler handler);
+
+    // Both return false once the stream has failed or been stopped
+    bool feed(const QByteArray& bytes);
+    bool finish(); // true if the document was complete and well formed
+    // Feeds a device to its end in chunks, then finishes
+    bool readAll(QIODevice& device, qint64 chunkSize = 64 * 1024);
+
+    QJsonObject fields() const; // root scalars read so far
+    int elementCount() const;
+    bool isStopped() const;
+    bool hasError() const;
+    QString errorString() const;
+
+private:
+    struct Frame {
+        bool isObject = true;
+        QJsonObject object;
+        QJsonArray array;
+        QString key;
+    };
+
+    bool pump();
+    void addValue(const QJsonValue& value);
+    void closeFrame();
+
+    JsonPullParser m_parser;
+    QString m_arrayKey;
+    ElementHandler m_handler;
+    int m_arrayDepth;  // depth inside the streamed array
+    bool m_inArray;
+    QString m_rootKey; // last key of the root object
+    QList<Frame> m_frames; // the element being built
+    QJsonObject m_fields;
+    int m_elements;
+    bool m_stopped;
+    bool m_finished;
+};
+
+#endif // JSONARRAYSTREAM_H
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include <QApplication>
 #include <QStyle>
 #include <QScreen>
+#include <QTextStream>
 #include "mainwindow.h"
+#include "formatbenchmark.h"
+#include "standinserver.h"
 
 int main(int argc, char *argv[])
 {
@@ -12,6 +15,56 @@ int main(int argc, char *argv[])
     app.setApplicationVersion("1.0");
     app.setOrganizationName("Quiz System");
     
+    // Storage format benchmark instead of the UI
+    if (app.arguments().contains("--benchmark-formats")) {
+        QTextStream out(stdout);
+        return runFormatBenchmark(out);
+    }
+    if (app.arguments().contains("--benchmark-memory")) {
+        QTextStream out(stdout);
+        return runMemoryBenchmark(out);
+    }
+    if (app.arguments().contains("--benchmark-startup")) {
+        QTextStream out(stdout);
+        return runStartupBenchmark(out);
+    }
+    if (app.arguments().contains("--benchmark-parse")) {
+        QTextStream out(stdout);
+        return runParseBenchmark(out);
+    }
+    if (app.arguments().contains("--benchmark-fetch")) {
+        QTextStream out(stdout);
+        return runFetchBenchmark(out);
+    }
+    
+    // Local stand-in for the providers, serving until killed:
+    // --standin [--port N] [--latency MS] [--items N] [--padding BYTES]
+    //           [--error-rate 0..1] [--chunk BYTES] [--chunk-delay MS]
+    if (app.arguments().contains("--standin")) {
+        const QStringList args = app.arguments();
+        auto option = [&args](const QString& name, const QString& fallback) {
+            int index = args.indexOf(name);
+            return index >= 0 && index + 1 < args.size() ? args[index + 1] : fallback;
+        };
+        StandInServer::Config config;
+        config.latencyMs = option("--latency", "0").toInt();
+        config.items = option("--items", "50").toInt();
+        config.paddingBytes = option("--padding", "0").toInt();
+        config.errorRate = option("--error-rate", "0").toDouble();
+        config.chunkBytes = option("--chunk", "0").toInt();
+        config.chunkDelayMs = option("--chunk-delay", "0").toInt();
+        StandInServer server(config);
+        QTextStream out(stdout);
+        if (!server.listen(option("--port", "0").toUShort())) {
+            out << "stand-in server could not listen" << Qt::endl;
+            return 1;
+        }
+        for (const QString& name : {"newsapi", "opentdb", "geeksforgeeks"}) {
+            out << name << ": " << server.providerUrl(name).toString() << Qt::endl;
+        }
+        return app.exec();
+    }
+    
     // Create and show main window
     MainWindow window;
     window.show();
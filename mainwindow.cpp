@@ -5,6 +5,7 @@
 #include <QMessageBox>
 #include <QScreen>
 #include <QGuiApplication>
+#include <QTimer>
 #include <QDebug> // Added for qDebug
 
 MainWindow::MainWindow(QWidget *parent)
@@ -94,6 +95,10 @@ MainWindow::MainWindow(QWidget *parent)
         windowGeometry.moveCenter(screenGeometry.center());
         setGeometry(windowGeometry);
     }
+    
+    // Offer to pick up a quiz the last run left unfinished, once the
+    // window is up
+    QTimer::singleShot(0, this, &MainWindow::offerSessionRecovery);
 }
 
 MainWindow::~MainWindow()
@@ -314,6 +319,26 @@ void MainWindow::setupSettingsScreen()
     m_adaptiveModeCheck->setChecked(true);
     quizLayout->addWidget(m_adaptiveModeCheck);
     
+    m_selectionCombo = new QComboBox();
+    m_selectionCombo->addItems(QuizManager::availableSelectionStrategies());
+    m_selectionCombo->setCurrentText(m_quizManager->getSelectionStrategy());
+    connect(m_selectionCombo, &QComboBox::currentTextChanged,
+            m_quizManager, &QuizManager::setSelectionStrategy);
+    quizLayout->addWidget(new QLabel("Question Selection:"));
+    quizLayout->addWidget(m_selectionCombo);
+    
+    m_customFormatCombo = new QComboBox();
+    m_customFormatCombo->addItem("Question pack (opens instantly)", static_cast<int>(QuizFileFormat::Pack));
+    m_customFormatCombo->addItem("CBOR", static_cast<int>(QuizFileFormat::Cbor));
+    m_customFormatCombo->addItem("JSON", static_cast<int>(QuizFileFormat::Json));
+    m_customFormatCombo->setCurrentIndex(
+        m_customFormatCombo->findData(static_cast<int>(m_quizManager->getCustomQuizFormat())));
+    connect(m_customFormatCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        m_quizManager->setCustomQuizFormat(static_cast<QuizFileFormat>(m_customFormatCombo->itemData(index).toInt()));
+    });
+    quizLayout->addWidget(new QLabel("Save Custom Quizzes As:"));
+    quizLayout->addWidget(m_customFormatCombo);
+    
     QHBoxLayout* questionCountLayout = new QHBoxLayout();
     questionCountLayout->addWidget(new QLabel("Number of Questions:"));
     m_questionCountSlider = new QSlider(Qt::Horizontal);
@@ -427,6 +452,11 @@ void MainWindow::onQuizFinished()
     );
     
     showAnalyticsScreen();
+    
+    // A quiz that ran out was finished by the manager before this point
+    if (m_quizManager->getRemainingMilliseconds() == 0) {
+        QMessageBox::information(this, "Time's Up!", "Time has expired, so the quiz was finished automatically.");
+    }
 }
 
 void MainWindow::onCustomQuizCreated(const QString& name, const QList<QuizQuestion>& questions)
@@ -436,8 +466,25 @@ void MainWindow::onCustomQuizCreated(const QString& name, const QList<QuizQuesti
     showQuizScreen();
 }
 
+void MainWindow::offerSessionRecovery()
+{
+    if (!m_quizManager->hasRecoverableSession()) return;
+    
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this, "Resume Quiz",
+        "A quiz was left unfinished. Do you want to resume it where you left off?");
+    if (reply == QMessageBox::Yes && m_quizManager->recoverSession()) {
+        showQuizScreen();
+        return;
+    }
+    
+    m_quizManager->discardRecoverableSession();
+}
+
 void MainWindow::showHomeScreen()
 {
+    // Leaving for home drops a fetch still on its way to the quiz
+    m_quizManager->cancelFetch();
     m_homeButton->setVisible(false);
     m_stackedWidget->setCurrentWidget(m_homeWidget);
 }
@@ -452,6 +499,9 @@ void MainWindow::showAnalyticsScreen()
 {
     m_homeButton->setVisible(true);
     m_stackedWidget->setCurrentWidget(m_analyticsWidget);
+    
+    // Likely followed by another quiz
+    m_quizManager->prefetchNextQuiz();
 }
 
 void MainWindow::showSettingsScreen()
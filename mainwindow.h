@@ -37,6 +37,7 @@ private slots:
     void showSettings();
     void onQuizFinished();
     void onCustomQuizCreated(const QString& name, const QList<QuizQuestion>& questions);
+    void offerSessionRecovery();
 
 private:
     // UI Components
@@ -59,6 +60,8 @@ private:
     QWidget* m_settingsWidget;
     QComboBox* m_timerCombo;
     QCheckBox* m_adaptiveModeCheck;
+    QComboBox* m_selectionCombo;
+    QComboBox* m_customFormatCombo;
     QSlider* m_questionCountSlider;
     QSpinBox* m_questionCountSpinBox;
     
@@ -0,0 +1,181 @@
+#include "persistenceservice.h"
+#include "resultslog.h"
+#include <QThread>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QBuffer>
+#include <QDebug>
+
+PersistenceService::PersistenceService(int capacity, QObject *parent)
+    : QObject(parent)
+    , m_capacity(qMax(1, capacity))
+    , m_nextSequence(1)
+    , m_busy(false)
+    , m_stopping(false)
+{
+    m_clock.start();
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("PersistenceService");
+    m_thread->start(QThread::LowPriority);
+}
+
+PersistenceService::~PersistenceService()
+{
+    // Everything queued is written before the worker stops
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+}
+
+void PersistenceService::replaceFile(const QString& path, Writer writer)
+{
+    QMutexLocker locker(&m_mutex);
+    quint64 sequence = m_nextSequence++;
+    m_pending[path] = Pending{writer, sequence};
+    
+    // A replacement of the same file that has not started yet takes the
+    // new contents; it keeps its place and its queue time
+    for (Job& queued : m_queue) {
+        if (queued.kind == Job::Replace && queued.path == path) {
+            queued.writer = writer;
+            queued.sequence = sequence;
+            m_stats.coalesced++;
+            return;
+        }
+    }
+    
+    locker.unlock();
+    Job job;
+    job.kind = Job::Replace;
+    job.path = path;
+    job.writer = writer;
+    job.sequence = sequence;
+    enqueue(job);
+}
+
+void PersistenceService::replaceFile(const QString& path, const QJsonDocument& document)
+{
+    replaceFile(path, [document](QIODevice& device) {
+        QByteArray bytes = document.toJson();
+        return device.write(bytes) == bytes.size();
+    });
+}
+
+void PersistenceService::appendResult(ResultsLog* log, const QJsonObject& record)
+{
+    Job job;
+    job.kind = Job::Append;
+    job.log = log;
+    job.record = record;
+    enqueue(job);
+}
+
+bool PersistenceService::pendingContents(const QString& path, QByteArray& contents) const
+{
+    Writer writer;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_pending.constFind(path);
+        if (it == m_pending.constEnd()) return false;
+        writer = it->writer;
+    }
+    
+    // Produced here rather than kept around; this is only for the rare
+    // read right after a write
+    contents.clear();
+    QBuffer buffer(&contents);
+    buffer.open(QIODevice::WriteOnly);
+    return writer(buffer);
+}
+
+void PersistenceService::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_queue.isEmpty() || m_busy) {
+        m_idle.wait(&m_mutex);
+    }
+}
+
+PersistenceService::Stats PersistenceService::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+void PersistenceService::enqueue(Job job)
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_queue.size() >= m_capacity) {
+        m_space.wait(&m_mutex);
+    }
+    
+    if (job.sequence == 0) {
+        job.sequence = m_nextSequence++;
+    }
+    job.queuedAt = m_clock.nsecsElapsed();
+    m_queue.enqueue(job);
+    m_wake.wakeOne();
+}
+
+void PersistenceService::run()
+{
+    QMutexLocker locker(&m_mutex);
+    forever {
+        while (m_queue.isEmpty() && !m_stopping) {
+            m_wake.wait(&m_mutex);
+        }
+        if (m_queue.isEmpty()) return; // stopping and drained
+        
+        Job job = m_queue.dequeue();
+        m_busy = true;
+        m_space.wakeOne();
+        locker.unlock();
+        
+        bool ok = write(job);
+        double durableMs = (m_clock.nsecsElapsed() - job.queuedAt) / 1e6;
+        
+        locker.relock();
+        m_busy = false;
+        if (job.kind == Job::Replace) {
+            // Readers fall back to the file once its latest version is on it
+            auto it = m_pending.find(job.path);
+            if (it != m_pending.end() && it->sequence == job.sequence) {
+                m_pending.erase(it);
+            }
+        }
+        
+        if (ok) {
+            m_stats.written++;
+            m_stats.lastDurableMs = durableMs;
+            m_stats.averageDurableMs += (durableMs - m_stats.averageDurableMs) / m_stats.written;
+            m_stats.maxDurableMs = qMax(m_stats.maxDurableMs, durableMs);
+        } else {
+            m_stats.failed++;
+            qDebug() << "Persistence write failed:" << (job.kind == Job::Replace ? job.path : QString("results log"));
+        }
+        
+        if (m_queue.isEmpty()) {
+            m_idle.wakeAll();
+        }
+    }
+}
+
+bool PersistenceService::write(const Job& job)
+{
+    if (job.kind == Job::Append) {
+        return job.log->append(job.record);
+    }
+    
+    QDir().mkpath(QFileInfo(job.path).path());
+    QSaveFile file(job.path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    if (!job.writer(file)) {
+        file.cancelWriting();
+    }
+    return file.commit();
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef PERSISTENCESERVICE_H
+#define PERSISTENCESERVICE_H
+
+#include <QObject>
+#include <QString>
+#include <QQueue>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <functional>
+
+class QThread;
+class QIODevice;
+class ResultsLog;
+
+// Write-behind persistence on a background thread. Callers queue a write
+// and return at once; serializing and writing happen on the worker.
+//
+// The queue is bounded: queuing into a full queue blocks until the worker
+// takes a job. Whole-file replacements go through QSaveFile, so a file is
+// either the old or the new version, and a replacement still waiting in
+// the queue is overwritten by a later one for the same path instead of
+// queuing another. Appends to a results log run in order.
+class PersistenceService : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        qint64 written = 0;      // writes completed
+        qint64 coalesced = 0;    // replacements merged into a queued one
+        qint64 failed = 0;
+        double lastDurableMs = 0.0;    // queue to committed, last write
+        double averageDurableMs = 0.0;
+        double maxDurableMs = 0.0;
+    };
+
+    // Writes a file's contents to a device. Runs on the worker thread, and
+    // on the caller's for pendingContents(), so it must only read what it
+    // captured.
+    using Writer = std::function<bool(QIODevice&)>;
+
+    explicit PersistenceService(int capacity = 64, QObject *parent = nullptr);
+    ~PersistenceService(); // flushes
+
+    // Atomically replaces the file at path with what writer produces
+    void replaceFile(const QString& path, Writer writer);
+    void replaceFile(const QString& path, const QJsonDocument& document);
+    // Appends record to log; log must outlive the write (see flush())
+    void appendResult(ResultsLog* log, const QJsonObject& record);
+
+    // The latest contents queued for path that are not on disk yet, so
+    // readers see their own writes
+    bool pendingContents(const QString& path, QByteArray& contents) const;
+
+    // Barrier: blocks until everything queued so far is written
+    void flush();
+    Stats stats() const;
+
+private:
+    struct Job {
+        enum Kind { Replace, Append };
+        Kind kind = Replace;
+        QString path;
+        Writer writer;
+        ResultsLog* log = nullptr;
+        QJsonObject record;
+        quint64 sequence = 0;
+        qint64 queuedAt = 0; // ns on m_clock
+    };
+
+    struct Pending {
+        Writer writer;
+        quint64 sequence = 0;
+    };
+
+    void enqueue(Job job);
+    void run();
+    static bool write(const Job& job);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_wake;  // work queued or stopping
+    QWaitCondition m_space; // a job left the queue
+    QWaitCondition m_idle;  // queue drained and worker idle
+    QQueue<Job> m_queue;
+    QHash<QString, Pending> m_pending; // replacements not yet committed
+    int m_capacity;
+    quint64 m_nextSequence;
+    bool m_busy;
+    bool m_stopping;
+    QElapsedTimer m_clock;
+    Stats m_stats;
+    QThread* m_thread;
+};
+
+#endif // PERSISTENCESERVICE_H
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "questionbank.h"
+#include "builtinbanks.h"
+#include <atomic>
+
+int QuestionSet::count() const
+{
+    return contents.size();
+}
+
+QList<QuizQuestion> QuestionSet::questions() const
+{
+    QList<QuizQuestion> questions;
+    questions.reserve(contents.size());
+    for (const QuestionContentPtr& content : contents) {
+        questions.append(QuizQuestion(content));
+    }
+    return questions;
+}
+
+QuestionBank& QuestionBank::instance()
+{
+    static QuestionBank bank;
+    return bank;
+}
+
+QuestionBank::QuestionBank()
+    : m_nextVersion(1)
+{
+    // The built-in banks are the first version of their sets
+    Catalog catalog;
+    catalog.insert("default", makeSet("default", builtinContents(BuiltinBankId::Default)));
+    catalog.insert("cpp_dsa", makeSet("cpp_dsa", builtinContents(BuiltinBankId::CppDsa)));
+    catalog.insert("current_affairs", makeSet("current_affairs", builtinContents(BuiltinBankId::CurrentAffairs)));
+    replaceCatalog(catalog);
+}
+
+QuestionSetPtr QuestionBank::snapshot(const QString& name) const
+{
+    return catalog()->value(name);
+}
+
+QStringList QuestionBank::names() const
+{
+    return catalog()->keys();
+}
+
+QuestionSetPtr QuestionBank::publish(const QString& name, const QList<QuizQuestion>& questions)
+{
+    QList<QuestionContentPtr> contents;
+    contents.reserve(questions.size());
+    for (const QuizQuestion& question : questions) {
+        contents.append(question.content());
+    }
+    return publish(name, contents);
+}
+
+QuestionSetPtr QuestionBank::publish(const QString& name, const QList<QuestionContentPtr>& contents)
+{
+    // Built outside the lock; only the swap is serialized
+    auto set = std::const_pointer_cast<QuestionSet>(makeSet(name, contents));
+    
+    QMutexLocker locker(&m_writeMutex);
+    set->version = m_nextVersion++;
+    Catalog next = *catalog();
+    next.insert(name, set);
+    replaceCatalog(next);
+    return set;
+}
+
+bool QuestionBank::remove(const QString& name)
+{
+    QMutexLocker locker(&m_writeMutex);
+    Catalog next = *catalog();
+    if (next.remove(name) == 0) return false;
+    replaceCatalog(next);
+    return true;
+}
+
+QuestionSetPtr QuestionBank::makeSet(const QString& name, const QList<QuestionContentPtr>& contents)
+{
+    auto set = std::make_shared<QuestionSet>();
+    set->name = name;
+    set->contents = contents;
+    
+    auto bank = std::make_shared<EngineBank>();
+    bank->reserve(contents.size());
+    for (const QuestionContentPtr& content : contents) {
+        bank->push_back(engineEntry(*content));
+    }
+    set->bank = std::move(bank);
+    return set;
+}
+
+EngineQuestion QuestionBank::engineEntry(const QuestionContent& content)
+{
+    EngineQuestion entry;
+    entry.difficulty = content.difficulty;
+    entry.correctIndex = static_cast<std::int8_t>(content.correctIndex);
+    return entry;
+}
+
+QString QuestionBank::customName(const QString& quizName)
+{
+    return "custom/" + quizName;
+}
+
+std::shared_ptr<const QuestionBank::Catalog> QuestionBank::catalog() const
+{
+    return std::atomic_load(&m_catalog);
+}
+
+void QuestionBank::replaceCatalog(const Catalog& catalog)
+{
+    std::atomic_store(&m_catalog, std::make_shared<const Catalog>(catalog));
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef QUESTIONBANK_H
+#define QUESTIONBANK_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QMutex>
+#include <memory>
+#include "quizquestion.h"
+#include "quizengine.h"
+
+// One version of a named question set. Immutable once published: the
+// question text is shared content and the engine bank is built once, so
+// any number of sessions can hold the same snapshot for the price of a
+// pointer each.
+struct QuestionSet {
+    QString name;
+    quint64 version = 0;
+    QList<QuestionContentPtr> contents;
+    EngineBankPtr bank; // parallel to contents
+
+    int count() const;
+    QList<QuizQuestion> questions() const; // fresh attempts over the shared content
+};
+
+using QuestionSetPtr = std::shared_ptr<const QuestionSet>;
+
+// Process-wide catalog of question sets, by name: the built-in banks
+// ("default", "cpp_dsa", "current_affairs") and custom quizzes
+// ("custom/<name>") once saved or loaded.
+//
+// Readers take a snapshot, which never changes under them; a session keeps
+// the snapshot it started with. A writer builds the new version of a set
+// before publishing it, then swaps in a new catalog, so readers never wait
+// for a writer: the catalog is an immutable map behind one atomically
+// replaced pointer, and writers only serialize among themselves.
+class QuestionBank
+{
+public:
+    static QuestionBank& instance();
+
+    QuestionBank(const QuestionBank&) = delete;
+    QuestionBank& operator=(const QuestionBank&) = delete;
+
+    // Current version of a set; null if there is none by that name
+    QuestionSetPtr snapshot(const QString& name) const;
+    QStringList names() const;
+
+    // Publishes questions as the next version of the named set
+    QuestionSetPtr publish(const QString& name, const QList<QuizQuestion>& questions);
+    QuestionSetPtr publish(const QString& name, const QList<QuestionContentPtr>& contents);
+    bool remove(const QString& name);
+
+    // A set that is not published, for questions only one session uses
+    static QuestionSetPtr makeSet(const QString& name, const QList<QuestionContentPtr>& contents);
+    static EngineQuestion engineEntry(const QuestionContent& content);
+    static QString customName(const QString& quizName);
+
+private:
+    using Catalog = QHash<QString, QuestionSetPtr>;
+
+    QuestionBank();
+    std::shared_ptr<const Catalog> catalog() const;
+    void replaceCatalog(const Catalog& catalog);
+
+    std::shared_ptr<const Catalog> m_catalog; // only through atomic_load/store
+    QMutex m_writeMutex;
+    quint64 m_nextVersion;
+};
+
+#endif // QUESTIONBANK_H
\ No newline at end of file
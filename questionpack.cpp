@@ -0,0 +1,357 @@
+#include "questionpack.h"
+#include <QIODevice>
+#include <QHash>
+#include <QPair>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+const char PackMagic[4] = {'Q', 'P', 'K', '1'};
+constexpr quint32 PackVersion = 1;
+constexpr qint64 HeaderSize = 64;
+constexpr qint64 BlockSize = 64 * 1024;
+constexpr qint64 ChecksumAt = 60;
+
+// zlib-compatible CRC-32; pass a previous result to continue it
+quint32 crc32(const uchar* data, qint64 size, quint32 previous = 0)
+{
+    static const QList<quint32> table = [] {
+        QList<quint32> entries(256);
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+        return entries;
+    }();
+    
+    quint32 crc = ~previous;
+    for (qint64 i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void put32(QByteArray& out, quint32 value)
+{
+    char bytes[4];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, 4);
+}
+
+void put64(QByteArray& out, quint64 value)
+{
+    char bytes[8];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, 8);
+}
+
+quint32 read32(const uchar* at)
+{
+    return qFromLittleEndian<quint32>(at);
+}
+
+quint64 read64(const uchar* at)
+{
+    return qFromLittleEndian<quint64>(at);
+}
+
+}
+
+QuestionPack::QuestionPack()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_count(0)
+    , m_blockCount(0)
+    , m_checksum(0)
+    , m_dataStart(0)
+    , m_metaOffset(0)
+    , m_indexOffset(0)
+    , m_recordsOffset(0)
+    , m_poolOffset(0)
+    , m_corrupt(false)
+{
+}
+
+QuestionPack::~QuestionPack()
+{
+}
+
+bool QuestionPack::open(const QString& path)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+    
+    // Mapped read-only; pages come in as questions are read. A file that
+    // cannot be mapped is read into memory instead.
+    qint64 size = m_file.size();
+    if (uchar* mapped = m_file.map(0, size)) {
+        return attach(mapped, size);
+    }
+    m_bytes = m_file.readAll();
+    m_file.close();
+    return attach(reinterpret_cast<const uchar*>(m_bytes.constData()), m_bytes.size());
+}
+
+bool QuestionPack::load(const QByteArray& bytes)
+{
+    m_bytes = bytes;
+    return attach(reinterpret_cast<const uchar*>(m_bytes.constData()), m_bytes.size());
+}
+
+bool QuestionPack::isPack(const QByteArray& head)
+{
+    return head.startsWith(QByteArray(PackMagic, 4));
+}
+
+bool QuestionPack::write(QIODevice& device, const QList<QuizQuestion>& questions)
+{
+    QByteArray meta;
+    QByteArray index;
+    QByteArray records;
+    QByteArray pool;
+    meta.reserve(questions.size() * 2);
+    index.reserve(questions.size() * 4);
+    
+    // Each distinct string goes into the pool once; a correct answer
+    // usually shares the bytes of its option
+    QHash<QString, QPair<quint32, quint32>> interned;
+    auto putString = [&](const QString& text) {
+        auto it = interned.constFind(text);
+        QPair<quint32, quint32> reference;
+        if (it != interned.constEnd()) {
+            reference = *it;
+        } else {
+            QByteArray utf8 = text.toUtf8();
+            reference = qMakePair(static_cast<quint32>(pool.size()), static_cast<quint32>(utf8.size()));
+            pool.append(utf8);
+            interned.insert(text, reference);
+        }
+        put32(records, reference.first);
+        put32(records, reference.second);
+    };
+    
+    for (const QuizQuestion& question : questions) {
+        const QuestionContent& content = *question.content();
+        int optionCount = qMin<int>(content.options.size(), 255);
+        meta.append(static_cast<char>(static_cast<int>(content.difficulty) | static_cast<int>(content.type) << 4));
+        meta.append(static_cast<char>(content.correctIndex < optionCount ? content.correctIndex : -1));
+        put32(index, static_cast<quint32>(records.size()));
+        
+        records.append(static_cast<char>(optionCount));
+        records.append("\0\0\0", 3);
+        putString(content.question);
+        for (int i = 0; i < optionCount; ++i) {
+            putString(content.options[i]);
+        }
+        putString(content.correctAnswer);
+    }
+    if (pool.size() > 0xffffffffLL || records.size() > 0xffffffffLL) return false;
+    
+    QByteArray data = meta + index + records + pool;
+    quint32 blockCount = static_cast<quint32>((data.size() + BlockSize - 1) / BlockSize);
+    qint64 dataStart = HeaderSize + 4 * static_cast<qint64>(blockCount);
+    
+    QByteArray blocks;
+    blocks.reserve(4 * blockCount);
+    const uchar* bytes = reinterpret_cast<const uchar*>(data.constData());
+    for (qint64 at = 0; at < data.size(); at += BlockSize) {
+        put32(blocks, crc32(bytes + at, qMin(BlockSize, data.size() - at)));
+    }
+    
+    QByteArray header;
+    header.reserve(HeaderSize);
+    header.append(PackMagic, 4);
+    put32(header, PackVersion);
+    put32(header, static_cast<quint32>(questions.size()));
+    put32(header, blockCount);
+    put64(header, dataStart);
+    put64(header, dataStart + meta.size());
+    put64(header, dataStart + meta.size() + index.size());
+    put64(header, dataStart + meta.size() + index.size() + records.size());
+    put64(header, dataStart + data.size());
+    put32(header, static_cast<quint32>(BlockSize));
+    quint32 checksum = crc32(reinterpret_cast<const uchar*>(header.constData()), ChecksumAt);
+    checksum = crc32(reinterpret_cast<const uchar*>(blocks.constData()), blocks.size(), checksum);
+    put32(header, checksum);
+    
+    return device.write(header) == header.size()
+        && device.write(blocks) == blocks.size()
+        && device.write(data) == data.size();
+}
+
+bool QuestionPack::isValid() const
+{
+    return m_data && !m_corrupt;
+}
+
+QString QuestionPack::path() const
+{
+    return m_file.fileName();
+}
+
+quint32 QuestionPack::checksum() const
+{
+    return m_checksum;
+}
+
+int QuestionPack::count() const
+{
+    return static_cast<int>(m_count);
+}
+
+QuestionContentPtr QuestionPack::question(int index) const
+{
+    if (!isValid() || index < 0 || index >= count()) return QuestionContentPtr();
+    
+    qint64 metaAt = m_metaOffset + 2 * static_cast<qint64>(index);
+    qint64 indexAt = m_indexOffset + 4 * static_cast<qint64>(index);
+    if (!verify(metaAt, metaAt + 2) || !verify(indexAt, indexAt + 4)) return QuestionContentPtr();
+    
+    qint64 recordAt = m_recordsOffset + read32(m_data + indexAt);
+    if (recordAt + 4 > m_poolOffset) {
+        m_corrupt = true;
+        return QuestionContentPtr();
+    }
+    int optionCount = m_data[recordAt];
+    qint64 recordEnd = recordAt + 4 + 8 * static_cast<qint64>(optionCount + 2);
+    if (recordEnd > m_poolOffset) {
+        m_corrupt = true;
+        return QuestionContentPtr();
+    }
+    if (!verify(recordAt, recordEnd)) return QuestionContentPtr();
+    
+    const uchar* reference = m_data + recordAt + 4;
+    QSharedPointer<QuestionContent> content = QSharedPointer<QuestionContent>::create();
+    content->question = poolString(reference);
+    content->options.reserve(optionCount);
+    for (int i = 0; i < optionCount; ++i) {
+        reference += 8;
+        content->options.append(poolString(reference));
+    }
+    content->correctAnswer = poolString(reference + 8);
+    
+    uchar flags = m_data[metaAt];
+    content->difficulty = static_cast<Difficulty>(qMin(flags & 0x0f, 2));
+    content->type = (flags >> 4) & 1 ? QuestionType::TrueFalse : QuestionType::MultipleChoice;
+    content->correctIndex = static_cast<qint8>(m_data[metaAt + 1]);
+    
+    if (m_corrupt) return QuestionContentPtr();
+    return content;
+}
+
+QList<QuizQuestion> QuestionPack::questions() const
+{
+    QList<QuizQuestion> questions;
+    questions.reserve(count());
+    for (int i = 0; i < count(); ++i) {
+        QuestionContentPtr content = question(i);
+        if (!content) break;
+        questions.append(QuizQuestion(content));
+    }
+    return questions;
+}
+
+EngineBankPtr QuestionPack::engineBank() const
+{
+    if (m_bank || !isValid()) return m_bank;
+    
+    // Reads only the meta section, two bytes a question
+    qint64 metaEnd = m_metaOffset + 2 * static_cast<qint64>(m_count);
+    if (!verify(m_metaOffset, metaEnd)) return m_bank;
+    
+    auto bank = std::make_shared<EngineBank>();
+    bank->reserve(m_count);
+    for (const uchar* at = m_data + m_metaOffset; at < m_data + metaEnd; at += 2) {
+        EngineQuestion entry;
+        entry.difficulty = static_cast<Difficulty>(qMin(at[0] & 0x0f, 2));
+        entry.correctIndex = static_cast<std::int8_t>(at[1]);
+        bank->push_back(entry);
+    }
+    m_bank = std::move(bank);
+    return m_bank;
+}
+
+bool QuestionPack::attach(const uchar* data, qint64 size)
+{
+    m_data = nullptr;
+    m_bank.reset();
+    m_corrupt = false;
+    if (size < HeaderSize || std::memcmp(data, PackMagic, 4) != 0) return false;
+    if (read32(data + 4) != PackVersion || read32(data + 56) != BlockSize) return false;
+    
+    quint32 count = read32(data + 8);
+    quint32 blockCount = read32(data + 12);
+    qint64 dataStart = HeaderSize + 4 * static_cast<qint64>(blockCount);
+    if (dataStart > size || static_cast<qint64>(read64(data + 48)) != size) return false;
+    if ((size - dataStart + BlockSize - 1) / BlockSize != blockCount) return false;
+    
+    // The header and block table are all that is checked up front
+    quint32 checksum = crc32(data, ChecksumAt);
+    checksum = crc32(data + HeaderSize, 4 * static_cast<qint64>(blockCount), checksum);
+    if (checksum != read32(data + ChecksumAt)) {
+        qDebug() << "Question pack header checksum mismatch";
+        return false;
+    }
+    
+    qint64 metaOffset = static_cast<qint64>(read64(data + 16));
+    qint64 indexOffset = static_cast<qint64>(read64(data + 24));
+    qint64 recordsOffset = static_cast<qint64>(read64(data + 32));
+    qint64 poolOffset = static_cast<qint64>(read64(data + 40));
+    if (metaOffset != dataStart || indexOffset != metaOffset + 2 * static_cast<qint64>(count)
+        || recordsOffset != indexOffset + 4 * static_cast<qint64>(count)
+        || poolOffset < recordsOffset || poolOffset > size) {
+        return false;
+    }
+    
+    m_data = data;
+    m_size = size;
+    m_count = count;
+    m_blockCount = blockCount;
+    m_checksum = checksum;
+    m_dataStart = dataStart;
+    m_metaOffset = metaOffset;
+    m_indexOffset = indexOffset;
+    m_recordsOffset = recordsOffset;
+    m_poolOffset = poolOffset;
+    m_verified = QBitArray(static_cast<qsizetype>(blockCount));
+    return true;
+}
+
+bool QuestionPack::verify(qint64 begin, qint64 end) const
+{
+    if (m_corrupt) return false;
+    if (begin >= end) return true;
+    
+    qint64 first = (begin - m_dataStart) / BlockSize;
+    qint64 last = (end - 1 - m_dataStart) / BlockSize;
+    for (qint64 block = first; block <= last; ++block) {
+        if (m_verified.testBit(block)) continue;
+        
+        qint64 at = m_dataStart + block * BlockSize;
+        quint32 expected = read32(m_data + HeaderSize + 4 * block);
+        if (crc32(m_data + at, qMin(BlockSize, m_size - at)) != expected) {
+            qDebug() << "Question pack block" << block << "failed its checksum";
+            m_corrupt = true;
+            return false;
+        }
+        m_verified.setBit(block);
+    }
+    return true;
+}
+
+QString QuestionPack::poolString(const uchar* reference) const
+{
+    qint64 begin = m_poolOffset + read32(reference);
+    qint64 end = begin + read32(reference + 4);
+    if (end > m_size) {
+        m_corrupt = true;
+        return QString();
+    }
+    if (!verify(begin, end)) return QString();
+    return QString::fromUtf8(reinterpret_cast<const char*>(m_data + begin), end - begin);
+}
\ No newline at end of file
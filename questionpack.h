@@ -0,0 +1,85 @@
+#ifndef QUESTIONPACK_H
+#define QUESTIONPACK_H
+
+#include <QString>
+#include <QList>
+#include <QFile>
+#include <QByteArray>
+#include <QBitArray>
+#include <memory>
+#include "quizquestion.h"
+#include "quizengine.h"
+
+class QIODevice;
+
+// Read-only question bank file, used in place without parsing.
+//
+// Layout (little endian):
+//   header         64 bytes: magic "QPK1", version, counts, section offsets
+//                  and a CRC-32 over the header and the block table
+//   block table    CRC-32 of each 64 KB block of everything that follows
+//   meta           2 bytes per question: difficulty | type << 4, correct
+//                  option index; all the engine needs to run a quiz
+//   offset table   u32 per question: its record, from the records start
+//   records        option count, then (offset, length) pool references for
+//                  the question, each option and the correct answer
+//   string pool    UTF-8, each distinct string stored once
+//
+// open() maps the file and checks only the header and block table, so it
+// costs the same for ten questions or a million. A question is decoded
+// when it is asked for, and each block is checked against its CRC the
+// first time anything in it is read; a block that fails marks the pack
+// corrupt and nothing more is decoded from it.
+class QuestionPack
+{
+public:
+    QuestionPack();
+    ~QuestionPack();
+    
+    QuestionPack(const QuestionPack&) = delete;
+    QuestionPack& operator=(const QuestionPack&) = delete;
+    
+    // Maps a pack file
+    bool open(const QString& path);
+    // Uses a pack already in memory
+    bool load(const QByteArray& bytes);
+    
+    static bool isPack(const QByteArray& head); // by its first bytes
+    static bool write(QIODevice& device, const QList<QuizQuestion>& questions);
+    
+    bool isValid() const; // opened and nothing failed its checksum
+    QString path() const; // empty when loaded from memory
+    quint32 checksum() const; // header CRC, identifies the contents
+    int count() const;
+    
+    // Decodes one question; null if out of range or corrupt
+    QuestionContentPtr question(int index) const;
+    // Every question decoded, for callers that want the whole list
+    QList<QuizQuestion> questions() const;
+    // Difficulty and correct option of every question, built from the
+    // meta section once and shared
+    EngineBankPtr engineBank() const;
+    
+private:
+    bool attach(const uchar* data, qint64 size);
+    bool verify(qint64 begin, qint64 end) const; // checks the blocks covering [begin, end)
+    QString poolString(const uchar* reference) const;
+    
+    QFile m_file;
+    QByteArray m_bytes;     // backing store when loaded from memory
+    const uchar* m_data;
+    qint64 m_size;
+    quint32 m_count;
+    quint32 m_blockCount;
+    quint32 m_checksum;
+    qint64 m_dataStart;
+    qint64 m_metaOffset;
+    qint64 m_indexOffset;
+    qint64 m_recordsOffset;
+    qint64 m_poolOffset;
+    mutable QBitArray m_verified;
+    mutable bool m_corrupt;
+    mutable EngineBankPtr m_bank;
+};
+
+#endif // QUESTIONPACK_H
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef QUESTIONSOURCE_H
+#define QUESTIONSOURCE_H
+
+#include <QtPlugin>
+#include <QString>
+#include <QUrl>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QVariantMap>
+#include <random>
+#include "quizquestion.h"
+
+// A question provider: where to ask for questions and how to read the
+// answer. ApiManager does the rest (caching, coalescing, deadlines,
+// parsing on its pool, fallbacks), so a source holds no network code.
+//
+// The response is a JSON object whose array arrayKey() holds one element
+// per question; it is usable when its root field statusKey() equals
+// okStatus(). toQuestion() runs on the parse pool, on several threads at
+// once for concurrent fetches, so it must only read the source.
+//
+// Sources are built in (builtinsources.h) or loaded from plugins: a
+// QObject that implements this interface, declares
+// Q_PLUGIN_METADATA(IID QuestionSource_iid) and Q_INTERFACES(QuestionSource),
+// and is placed in the questionsources directory next to the executable.
+class QuestionSource
+{
+public:
+    virtual ~QuestionSource() = default;
+
+    // Unique; also names the source's sets in the question set cache
+    virtual QString name() const = 0;
+
+    // Settings by name; every source takes "url" for its endpoint, which
+    // is how tests point it at a stand-in server
+    virtual void configure(const QVariantMap& settings) = 0;
+
+    // Request for count questions, 0 for as many as there are. An empty
+    // URL means the source is not configured, such as a missing API key,
+    // and fetches from it get the local fallback instead.
+    virtual QUrl requestUrl(int count) const = 0;
+    // The same query with secrets such as API keys left out
+    virtual QString cacheKey(int count) const = 0;
+
+    virtual QString arrayKey() const = 0;
+    virtual QString statusKey() const = 0;
+    virtual QJsonValue okStatus() const = 0;
+
+    // One element to a question; false for one that makes none. rng is
+    // the response's own generator.
+    virtual bool toQuestion(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question) const = 0;
+};
+
+#define QuestionSource_iid "org.quizsystem.QuestionSource/1.0"
+Q_DECLARE_INTERFACE(QuestionSource, QuestionSource_iid)
+
+#endif // QUESTIONSOURCE_H
\ No newline at end of file
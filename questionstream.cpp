@@ -0,0 +1,85 @@
+#include "questionstream.h"
+
+QuestionStream::QuestionStream(int capacity, QObject *parent)
+    : QObject(parent)
+    , m_queue(static_cast<std::size_t>(qMax(1, capacity)))
+    , m_wakeupPending(false)
+    , m_closed(false)
+    , m_fellBack(false)
+    , m_cancelled(false)
+    , m_pushed(0)
+    , m_dropped(0)
+{
+}
+
+bool QuestionStream::push(const QuizQuestion& question)
+{
+    if (m_cancelled.load(std::memory_order_relaxed) || !m_queue.tryPush(question.content())) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_pushed.fetch_add(1, std::memory_order_relaxed);
+    wake();
+    return true;
+}
+
+void QuestionStream::close(bool fellBack)
+{
+    m_fellBack.store(fellBack, std::memory_order_relaxed);
+    m_closed.store(true, std::memory_order_release);
+    wake();
+}
+
+bool QuestionStream::isCancelled() const
+{
+    return m_cancelled.load(std::memory_order_relaxed);
+}
+
+QList<QuestionContentPtr> QuestionStream::takeAvailable()
+{
+    // Clearing the flag first means a push that lands during the drain
+    // either is taken here or sends a fresh wakeup. Both sides exchange the
+    // flag, so the producer's pushes are visible once it is seen set.
+    m_wakeupPending.exchange(false, std::memory_order_acq_rel);
+    
+    QList<QuestionContentPtr> contents;
+    QuestionContentPtr content;
+    while (m_queue.tryPop(content)) {
+        contents.append(content);
+    }
+    return contents;
+}
+
+bool QuestionStream::isFinished() const
+{
+    return m_closed.load(std::memory_order_acquire) && m_queue.size() == 0;
+}
+
+bool QuestionStream::fellBack() const
+{
+    return m_closed.load(std::memory_order_acquire) && m_fellBack.load(std::memory_order_relaxed);
+}
+
+void QuestionStream::cancel()
+{
+    m_cancelled.store(true, std::memory_order_relaxed);
+}
+
+int QuestionStream::pushedCount() const
+{
+    return m_pushed.load(std::memory_order_relaxed);
+}
+
+int QuestionStream::droppedCount() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void QuestionStream::wake()
+{
+    // One signal per batch: only the push that finds no wakeup pending
+    // sends one
+    if (!m_wakeupPending.exchange(true, std::memory_order_acq_rel)) {
+        emit questionsAvailable();
+    }
+}
\ No newline at end of file
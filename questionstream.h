@@ -0,0 +1,57 @@
+#ifndef QUESTIONSTREAM_H
+#define QUESTIONSTREAM_H
+
+#include <QObject>
+#include <QList>
+#include <atomic>
+#include "quizquestion.h"
+#include "spscqueue.h"
+
+// Carries questions from the thread that fetches and parses them to a quiz
+// on the thread the stream lives in, one at a time as each is ready, so a
+// quiz can start on the first question instead of waiting for the last.
+//
+// One producer and one consumer share a lock-free ring sized to the
+// request. The producer may move between threads, like the tasks parsing
+// one response, as long as its pushes never overlap. It never blocks: a
+// push into a full or cancelled stream is dropped. The consumer is woken
+// by questionsAvailable(), which is emitted once per batch: only when the
+// stream goes from drained to holding something, not per question.
+class QuestionStream : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QuestionStream(int capacity, QObject *parent = nullptr);
+
+    // Producer side
+    bool push(const QuizQuestion& question);
+    void close(bool fellBack = false); // nothing more follows
+    bool isCancelled() const;
+
+    // Consumer side
+    QList<QuestionContentPtr> takeAvailable();
+    bool isFinished() const; // closed and everything taken
+    bool fellBack() const;   // once closed: the fetch failed or came up
+                             // short, and local questions filled it in
+    void cancel();           // the producer stops at its next push
+
+    int pushedCount() const;
+    int droppedCount() const;
+
+signals:
+    void questionsAvailable();
+
+private:
+    void wake();
+
+    SpscQueue<QuestionContentPtr> m_queue;
+    std::atomic<bool> m_wakeupPending;
+    std::atomic<bool> m_closed;
+    std::atomic<bool> m_fellBack;
+    std::atomic<bool> m_cancelled;
+    std::atomic<int> m_pushed;
+    std::atomic<int> m_dropped;
+};
+
+#endif // QUESTIONSTREAM_H
\ No newline at end of file
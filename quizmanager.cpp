@@ -5,369 +5,696 @@
 #include <QFile>
 #include <QDir>
 #include <QStandardPaths>
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QDataStream>
+#include <QFileInfo>
 #include <algorithm>
 #include <QRandomGenerator>
 #include <QDebug> // Added for qDebug
+#include <limits>
+
+namespace {
+// Events held in memory before the journal is written out, and how long
+// the first of them may wait
+constexpr int JournalBatchEvents = 32;
+constexpr int JournalFlushDelayMs = 250;
+
+// Questions fetched for the default quiz
+constexpr int FetchedQuestionCount = 15;
+}
 
 QuizManager::QuizManager(QObject *parent)
     : QObject(parent)
-    , m_isActive(false)
-    , m_isPaused(false)
-    , m_currentIndex(0)
-    , m_totalQuestions(0)
-    , m_answeredCount(0)
-    , m_correctCount(0)
-    , m_remainingTime(0)
-    , m_currentDifficulty(Difficulty::Easy)
-    , m_consecutiveCorrect(0)
-    , m_consecutiveWrong(0)
-    , m_easyCorrect(0)
-    , m_mediumCorrect(0)
-    , m_hardCorrect(0)
+    , m_engine(QRandomGenerator::global()->generate64())
+    , m_quizDeadline(TimerWheel::InvalidTimer)
+    , m_questionDeadline(TimerWheel::InvalidTimer)
+    , m_remainingMs(0)
+    , m_questionRemainingMs(0)
     , m_initialTime(1800) // 30 minutes default
+    , m_questionTimeLimit(0)
+    , m_clockOffset(0)
     , m_apiManager(new ApiManager(this))
+    , m_fetchRequest(0)
+    , m_prefetcher(new QuizPrefetcher(m_apiManager, FetchedQuestionCount, this))
+    , m_progressiveStart(true)
+    , m_providerFanOut(false)
+    , m_timeToFirstQuestionMs(-1)
+    , m_resultsLog(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation))
+    , m_persistence(new PersistenceService(64, this))
 {
-    // Setup timer
-    m_timer = new QTimer(this);
-    m_timer->setInterval(1000); // 1 second
-    connect(m_timer, &QTimer::timeout, this, &QuizManager::updateTimer);
+    // Monotonic clock the deadlines are measured on
+    m_clock.start();
+    
+    // Single-shot timer armed for the earliest pending deadline
+    m_deadlineTimer = new QTimer(this);
+    m_deadlineTimer->setSingleShot(true);
+    m_deadlineTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_deadlineTimer, &QTimer::timeout, this, &QuizManager::processDeadlines);
+    
+    // Batched journal writes
+    m_journalTimer = new QTimer(this);
+    m_journalTimer->setSingleShot(true);
+    connect(m_journalTimer, &QTimer::timeout, this, &QuizManager::flushJournal);
+    
+    // Saves run on the persistence thread
+    m_apiManager->setPersistenceService(m_persistence);
+    
+    // Custom quizzes are saved as packs; ApiManager keeps JSON as its own
+    // default for callers that exchange files
+    m_apiManager->setCustomQuizFormat(QuizFileFormat::Pack);
+    
+    // Question source plugins shipped next to the executable
+    m_apiManager->loadSourcePlugins(QCoreApplication::applicationDirPath() + "/questionsources");
     
     // Connect API signals
     connect(m_apiManager, &ApiManager::questionsFetched, 
             this, &QuizManager::onQuestionsFetched);
-    connect(m_apiManager, &ApiManager::errorOccurred, 
-            this, &QuizManager::onApiError);
-    
-    // Initialize analytics
-    m_difficultyStats[Difficulty::Easy] = 0;
-    m_difficultyStats[Difficulty::Medium] = 0;
-    m_difficultyStats[Difficulty::Hard] = 0;
-    
-    m_correctByDifficulty[Difficulty::Easy] = 0;
-    m_correctByDifficulty[Difficulty::Medium] = 0;
-    m_correctByDifficulty[Difficulty::Hard] = 0;
+    connect(m_apiManager, &ApiManager::requestFailed, 
+            this, &QuizManager::onRequestFailed);
 }
 
 QuizManager::~QuizManager()
 {
+    // A quiz still running on exit stays recoverable
+    flushJournal();
+    
+    // Barrier: queued saves reach disk before the results log goes away
+    m_persistence->flush();
 }
 
 void QuizManager::startQuiz(const QString& quizType)
 {
-    if (m_isActive) return;
+    if (m_engine.isActive()) return;
     
     resetQuiz();
+    m_firstQuestionTimer.start();
+    m_prefetcher->noteQuizStarted(quizType);
     
     if (quizType == "cpp_dsa") {
-        m_questions = m_apiManager->getCppDSAQuestions();
+        beginSession(QuestionBank::instance().snapshot("cpp_dsa"));
     } else if (quizType == "custom") {
         // Custom quiz will be loaded separately
         return;
+    } else if (QuestionSetPtr ready = m_prefetcher->take(quizType)) {
+        // Fetched while the last quiz ran
+        beginSession(ready);
+    } else if (m_progressiveStart) {
+        // Default: fetch from API, starting on the first question parsed.
+        // Questions are pushed from the parse pool and taken here in
+        // batches, one queued wakeup per batch.
+        m_stream = QSharedPointer<QuestionStream>(new QuestionStream(FetchedQuestionCount),
+                                                  &QObject::deleteLater);
+        connect(m_stream.data(), &QuestionStream::questionsAvailable,
+                this, &QuizManager::onStreamedQuestions, Qt::QueuedConnection);
+        m_fetchRequest = m_providerFanOut
+            ? m_apiManager->fetchFromProviders(FetchedQuestionCount, m_stream)
+            : m_apiManager->fetchQuestions(FetchedQuestionCount, m_stream);
     } else {
         // Default: fetch from API
-        m_apiManager->fetchQuestions(15);
-        return;
+        m_fetchRequest = m_providerFanOut
+            ? m_apiManager->fetchFromProviders(FetchedQuestionCount)
+            : m_apiManager->fetchQuestions(FetchedQuestionCount);
     }
     
-    // Initialize DSA structures for intelligent question selection
-    m_totalQuestions = m_questions.size();
-    m_timePerQuestion.resize(m_totalQuestions);
-    initializeQuestionQueue();
-    
-    m_isActive = true;
-    m_remainingTime = m_initialTime;
-    m_timer->start();
-    
-    emit quizStarted();
-    emit questionChanged(0);
-    emit progressUpdated(0, m_totalQuestions);
+    // A prefetch still on its way is the same request: the quiz has just
+    // joined its transfer, and the prefetch lets go of it
+    if (m_fetchRequest) {
+        m_prefetcher->cancel();
+    }
 }
 
 void QuizManager::pauseQuiz()
 {
-    if (!m_isActive || m_isPaused) return;
-    
-    m_isPaused = true;
-    m_timer->stop();
+    if (!m_engine.isActive() || m_engine.isPaused()) return;
+    
+    // Freeze what is left of each deadline and drop them from the wheel.
+    // One reading of the clock serves the engine and the journal, so a
+    // replay sees the same times.
+    quint64 current = now();
+    m_remainingMs = remainingMillisecondsAt(current);
+    m_questionRemainingMs = m_deadlines.isPending(m_questionDeadline)
+        ? qMax<qint64>(0, static_cast<qint64>(m_deadlines.deadline(m_questionDeadline) - current))
+        : 0;
+    m_engine.pause(current);
+    journal(current, SessionEventType::Pause);
+    flushJournal();
+    cancelDeadlines();
+    m_deadlineTimer->stop();
     emit quizPaused();
 }
 
 void QuizManager::resumeQuiz()
 {
-    if (!m_isActive || !m_isPaused) return;
+    quint64 current = now();
+    if (!m_engine.resume(current)) return;
+    journal(current, SessionEventType::Resume);
     
-    m_isPaused = false;
-    m_timer->start();
+    m_quizDeadline = m_deadlines.schedule(current + m_remainingMs, QuizDeadline);
+    if (m_questionTimeLimit > 0) {
+        scheduleQuestionDeadline(m_questionRemainingMs);
+    }
+    armDeadlineTimer();
     emit quizResumed();
 }
 
 void QuizManager::finishQuiz()
 {
-    if (!m_isActive) return;
+    if (!m_engine.isActive()) return;
     
-    m_isActive = false;
-    m_timer->stop();
+    quint64 current = now();
+    m_remainingMs = remainingMillisecondsAt(current);
+    m_engine.finish(current);
+    cancelDeadlines();
+    m_deadlineTimer->stop();
     calculateStats();
     saveQuizResults();
+    discardJournal();
     
     emit quizFinished();
 }
 
 void QuizManager::resetQuiz()
 {
-    m_isActive = false;
-    m_isPaused = false;
-    m_currentIndex = 0;
-    m_answeredCount = 0;
-    m_correctCount = 0;
-    m_remainingTime = m_initialTime;
-    m_consecutiveCorrect = 0;
-    m_consecutiveWrong = 0;
-    m_easyCorrect = 0;
-    m_mediumCorrect = 0;
-    m_hardCorrect = 0;
-    
-    m_questions.clear();
-    m_questionHistory.clear();
-    m_timePerQuestion.clear();
-    
-    // Reset analytics
-    m_difficultyStats.clear();
-    m_correctByDifficulty.clear();
-    m_difficultyStats[Difficulty::Easy] = 0;
-    m_difficultyStats[Difficulty::Medium] = 0;
-    m_difficultyStats[Difficulty::Hard] = 0;
-    m_correctByDifficulty[Difficulty::Easy] = 0;
-    m_correctByDifficulty[Difficulty::Medium] = 0;
-    m_correctByDifficulty[Difficulty::Hard] = 0;
+    cancelFetch();
+    m_engine.reset();
+    m_set.reset();
+    m_ownedSet.reset();
+    m_ownedBank.reset();
+    m_pack.reset();
+    m_contentCache.clear();
+    discardJournal();
+    cancelDeadlines();
+    m_deadlineTimer->stop();
+    m_remainingMs = static_cast<qint64>(m_initialTime) * 1000;
 }
 
-void QuizManager::nextQuestion()
+void QuizManager::cancelFetch()
 {
-    qDebug() << "QuizManager::nextQuestion - Current index:" << m_currentIndex << "Total:" << m_totalQuestions;
-    if (!m_isActive || m_currentIndex >= m_totalQuestions - 1) {
-        qDebug() << "Cannot go to next question - quiz not active or at last question";
-        return;
+    if (m_fetchRequest) {
+        m_apiManager->cancelRequest(m_fetchRequest);
+        m_fetchRequest = 0;
     }
-    
-    // Save current question time
-    if (m_currentIndex < m_timePerQuestion.size()) {
-        m_timePerQuestion[m_currentIndex] = m_initialTime - m_remainingTime;
+    if (m_stream) {
+        // A fetch still streaming into the last quiz stops at its next push
+        m_stream->cancel();
+        disconnect(m_stream.data(), nullptr, this, nullptr);
+        m_stream.reset();
     }
-    
-    m_questionHistory.push(m_currentIndex);
-    m_currentIndex++;
-    
-    qDebug() << "Moving to question" << m_currentIndex;
-    emit questionChanged(m_currentIndex);
-    emit progressUpdated(m_answeredCount, m_totalQuestions);
 }
 
-void QuizManager::previousQuestion()
+void QuizManager::beginSession(const QList<QuizQuestion>& questions)
 {
-    qDebug() << "QuizManager::previousQuestion - Current index:" << m_currentIndex;
-    if (!m_isActive || m_questionHistory.isEmpty()) {
-        qDebug() << "Cannot go to previous question - quiz not active or no history";
-        return;
+    // Questions only this quiz uses, such as a fetch, get a set of their
+    // own that is not published
+    QList<QuestionContentPtr> contents;
+    contents.reserve(questions.size());
+    for (const QuizQuestion& question : questions) {
+        contents.append(question.content());
     }
-    
-    m_currentIndex = m_questionHistory.pop();
-    qDebug() << "Moving to question" << m_currentIndex;
-    emit questionChanged(m_currentIndex);
-    emit progressUpdated(m_answeredCount, m_totalQuestions);
+    beginSession(QuestionBank::makeSet("session", contents));
 }
 
-void QuizManager::goToQuestion(int index)
+void QuizManager::beginSession(const QuestionSetPtr& set)
 {
-    qDebug() << "QuizManager::goToQuestion - Index:" << index << "Total:" << m_totalQuestions;
-    if (!m_isActive || index < 0 || index >= m_totalQuestions) {
-        qDebug() << "Cannot go to question - invalid index or quiz not active";
+    // The engine only needs difficulty and the correct option of each
+    // question, built once per set version and shared with every other
+    // session on it; the text stays in the set, index for index. A
+    // published set is journaled by name, and only questions this session
+    // alone has, such as a fetch, go into the journal as text.
+    m_pack.reset();
+    m_contentCache.clear();
+    m_set = set;
+    bool published = QuestionBank::instance().snapshot(set->name) == set;
+    startSession(set->bank, published ? encodeSetReference(*set) : encodeContents(set->contents));
+}
+
+void QuizManager::beginSession(const QSharedPointer<const QuestionPack>& pack)
+{
+    // Nothing is decoded up front: the engine bank comes from the pack's
+    // meta section and the journal refers to the pack instead of copying
+    // its text
+    EngineBankPtr bank = pack->engineBank();
+    if (!bank) {
+        qDebug() << "Question pack is damaged:" << pack->path();
         return;
     }
-    
-    m_currentIndex = index;
-    qDebug() << "Moving to question" << m_currentIndex;
-    emit questionChanged(m_currentIndex);
-    emit progressUpdated(m_answeredCount, m_totalQuestions);
+    m_set.reset();
+    m_pack = pack;
+    m_contentCache.clear();
+    startSession(std::move(bank), encodePackReference(*pack));
 }
 
-void QuizManager::answerQuestion(const QString& answer)
+void QuizManager::startSession(EngineBankPtr bank, const QByteArray& content)
 {
-    if (!m_isActive || m_currentIndex >= m_questions.size()) return;
+    // A fresh seed per session, so the journal can replay its selections
+    quint64 seed = QRandomGenerator::global()->generate64();
+    quint64 startTime = now();
+    m_engine.seed(seed);
+    m_engine.start(std::move(bank), startTime);
+    
+    // Quiz and first question deadlines, measured from now
+    cancelDeadlines();
+    m_remainingMs = static_cast<qint64>(m_initialTime) * 1000;
+    
+    SessionStart start;
+    start.seed = seed;
+    start.time = startTime;
+    start.strategy = m_engine.selectionStrategy();
+    start.quizDurationMs = static_cast<std::uint32_t>(m_remainingMs);
+    start.questionLimitMs = static_cast<std::uint32_t>(m_questionTimeLimit) * 1000;
+    start.bank = *m_engine.bank();
+    start.content.assign(content.constData(), content.size());
+    openJournal(start);
+    
+    if (m_firstQuestionTimer.isValid()) {
+        m_timeToFirstQuestionMs = m_firstQuestionTimer.elapsed();
+        m_firstQuestionTimer.invalidate();
+    }
     
-    QuizQuestion& currentQuestion = m_questions[m_currentIndex];
-    currentQuestion.setUserAnswer(answer);
-    currentQuestion.setTimeSpent(m_initialTime - m_remainingTime);
+    m_quizDeadline = m_deadlines.schedule(now() + m_remainingMs, QuizDeadline);
+    scheduleQuestionDeadline(static_cast<qint64>(m_questionTimeLimit) * 1000);
+    armDeadlineTimer();
     
-    bool isCorrect = currentQuestion.isCorrect();
-    Difficulty questionDifficulty = currentQuestion.getDifficulty();
+    emit quizStarted();
+    emit questionChanged(0);
+    emit progressUpdated(0, m_engine.questionCount());
+    emit timeUpdated(m_initialTime);
     
-    // Update answered questions set (O(1) lookup)
-    m_answeredQuestions.insert(m_currentIndex);
+    // The next quiz's questions load while this one is played
+    m_prefetcher->prefetch();
+}
+
+void QuizManager::extendSession(const QList<QuestionContentPtr>& added)
+{
+    // The new questions go at the end, so every index already shown or
+    // answered keeps its question. The first growth copies the set into
+    // one this session owns; later ones append to it in place, so a quiz
+    // streamed in many batches is not rebuilt per batch. The engine grows
+    // over the same bank and the journal records the growth for a
+    // recovery to replay.
+    if (!m_set || !m_engine.isActive()) return;
+    if (m_ownedSet != m_set) {
+        m_ownedSet = std::make_shared<QuestionSet>(*m_set);
+        m_ownedSet->name = "session";
+        m_ownedBank = std::make_shared<EngineBank>(*m_set->bank);
+        m_ownedSet->bank = m_ownedBank;
+        m_set = m_ownedSet;
+    }
+    
+    int previous = m_engine.questionCount();
+    for (const QuestionContentPtr& content : added) {
+        m_ownedSet->contents.append(content);
+        m_ownedBank->push_back(QuestionBank::engineEntry(*content));
+    }
+    if (!m_engine.extend(m_ownedBank)) return;
+    
+    SessionEvent event;
+    event.type = SessionEventType::Extend;
+    event.time = now();
+    event.text = encodeBankEntries(*m_ownedBank, static_cast<std::size_t>(previous));
+    event.content = encodeContents(added).toStdString();
+    journal(event);
     
-    if (isCorrect) {
-        m_correctCount++;
-        m_consecutiveCorrect++;
-        m_consecutiveWrong = 0;
+    emit questionsAdded(m_engine.questionCount());
+    emit progressUpdated(m_engine.answeredCount(), m_engine.questionCount());
+}
+
+QuestionContentPtr QuizManager::content(int index) const
+{
+    if (m_pack) {
+        for (int i = 0; i < m_contentCache.size(); ++i) {
+            if (m_contentCache[i].first == index) {
+                m_contentCache.move(i, 0);
+                return m_contentCache.first().second;
+            }
+        }
         
-        // Track by difficulty
-        switch (questionDifficulty) {
-            case Difficulty::Easy: m_easyCorrect++; break;
-            case Difficulty::Medium: m_mediumCorrect++; break;
-            case Difficulty::Hard: m_hardCorrect++; break;
+        QuestionContentPtr decoded = m_pack->question(index);
+        if (decoded) {
+            m_contentCache.prepend(qMakePair(index, decoded));
+            if (m_contentCache.size() > ContentCacheSize) {
+                m_contentCache.removeLast();
+            }
         }
-    } else {
-        m_consecutiveWrong++;
-        m_consecutiveCorrect = 0;
+        return decoded;
+    }
+    return m_set && index >= 0 && index < m_set->count() ? m_set->contents[index] : QuestionContentPtr();
+}
+
+quint64 QuizManager::now() const
+{
+    return static_cast<quint64>(m_clock.elapsed() + m_clockOffset);
+}
+
+void QuizManager::scheduleQuestionDeadline(qint64 limitMs)
+{
+    if (m_questionDeadline != TimerWheel::InvalidTimer) {
+        m_deadlines.cancel(m_questionDeadline);
+        m_questionDeadline = TimerWheel::InvalidTimer;
     }
+    if (m_questionTimeLimit <= 0 || !m_engine.isActive() || m_engine.isPaused()) return;
     
-    m_answeredCount++;
+    m_questionDeadline = m_deadlines.schedule(now() + limitMs, QuestionDeadline);
+}
+
+void QuizManager::cancelDeadlines()
+{
+    m_deadlines.cancel(m_quizDeadline);
+    m_deadlines.cancel(m_questionDeadline);
+    m_quizDeadline = TimerWheel::InvalidTimer;
+    m_questionDeadline = TimerWheel::InvalidTimer;
+}
+
+void QuizManager::armDeadlineTimer()
+{
+    quint64 next = m_deadlines.nextDeadline();
+    if (next == UINT64_MAX) {
+        m_deadlineTimer->stop();
+        return;
+    }
     
-    // Update performance metrics for DSA algorithms
-    updatePerformanceMetrics(questionDifficulty, isCorrect, currentQuestion.getTimeSpent());
+    quint64 current = now();
+    qint64 delay = next > current ? static_cast<qint64>(next - current) : 0;
+    m_deadlineTimer->start(static_cast<int>(qMin<qint64>(delay, std::numeric_limits<int>::max())));
+}
+
+void QuizManager::processDeadlines()
+{
+    std::vector<std::uint64_t> expired;
+    m_deadlines.advance(now(), expired);
+    
+    for (std::uint64_t kind : expired) {
+        if (kind == QuizDeadline) {
+            m_quizDeadline = TimerWheel::InvalidTimer;
+            m_remainingMs = 0;
+            emit timeUpdated(0);
+            finishQuiz();
+            return;
+        }
+        
+        if (kind == QuestionDeadline) {
+            m_questionDeadline = TimerWheel::InvalidTimer;
+            emit questionTimeUp(m_engine.currentQuestionIndex());
+            if (hasNextQuestion()) {
+                nextQuestion();
+            }
+        }
+    }
     
-    // Update question weights for adaptive selection
-    updateQuestionWeights();
+    armDeadlineTimer();
+}
+
+void QuizManager::nextQuestion()
+{
+    qDebug() << "QuizManager::nextQuestion - Current index:" << m_engine.currentQuestionIndex() << "Total:" << m_engine.questionCount();
+    quint64 current = now();
+    int index = m_engine.next(current);
+    if (m_engine.isActive()) {
+        journal(current, SessionEventType::Next, index);
+    }
+    if (index == -1) {
+        qDebug() << "Cannot go to next question - quiz not active or no question left";
+        return;
+    }
     
-    // Update streaks
-    updateStreaks(isCorrect);
+    qDebug() << "Moving to question" << index;
+    scheduleQuestionDeadline(static_cast<qint64>(m_questionTimeLimit) * 1000);
+    armDeadlineTimer();
+    emit questionChanged(index);
+    emit progressUpdated(m_engine.answeredCount(), m_engine.questionCount());
+}
+
+void QuizManager::previousQuestion()
+{
+    qDebug() << "QuizManager::previousQuestion - Current index:" << m_engine.currentQuestionIndex();
+    quint64 current = now();
+    int index = m_engine.previous(current);
+    if (index == -1) {
+        qDebug() << "Cannot go to previous question - quiz not active or no history";
+        return;
+    }
+    journal(current, SessionEventType::Previous, index);
     
-    // Update difficulty based on performance
-    adjustDifficulty();
+    qDebug() << "Moving to question" << index;
+    scheduleQuestionDeadline(static_cast<qint64>(m_questionTimeLimit) * 1000);
+    armDeadlineTimer();
+    emit questionChanged(index);
+    emit progressUpdated(m_engine.answeredCount(), m_engine.questionCount());
+}
+
+void QuizManager::goToQuestion(int index)
+{
+    qDebug() << "QuizManager::goToQuestion - Index:" << index << "Total:" << m_engine.questionCount();
+    quint64 current = now();
+    if (m_engine.goTo(index, current) == -1) {
+        qDebug() << "Cannot go to question - invalid index or quiz not active";
+        return;
+    }
+    journal(current, SessionEventType::GoTo, index);
     
-    emit answerSubmitted(m_currentIndex, isCorrect);
-    emit progressUpdated(m_answeredCount, m_totalQuestions);
-    emit streakUpdated(m_consecutiveCorrect, m_consecutiveWrong);
+    qDebug() << "Moving to question" << index;
+    scheduleQuestionDeadline(static_cast<qint64>(m_questionTimeLimit) * 1000);
+    armDeadlineTimer();
+    emit questionChanged(index);
+    emit progressUpdated(m_engine.answeredCount(), m_engine.questionCount());
+}
+
+void QuizManager::answerQuestion(const QString& answer)
+{
+    int index = m_engine.currentQuestionIndex();
+    QuestionContentPtr current = content(index);
+    if (!m_engine.isActive() || !current) return;
+    
+    // Answers are scored as option indices; anything that is not one of
+    // the options counts as answered with no option selected
+    int option = current->options.indexOf(answer);
+    quint64 current = now();
+    AnswerResult result = m_engine.answer(option, current);
+    if (!result.accepted) return;
+    journal(current, SessionEventType::Answer, option);
+    
+    if (result.difficultyChanged) {
+        emit difficultyChanged(m_engine.currentDifficulty());
+    }
+    emit answerSubmitted(index, result.correct);
+    emit progressUpdated(m_engine.answeredCount(), m_engine.questionCount());
+    emit streakUpdated(m_engine.consecutiveCorrect(), m_engine.consecutiveWrong());
 }
 
 void QuizManager::clearAnswer()
 {
-    if (!m_isActive || m_currentIndex >= m_questions.size()) return;
-    
-    QuizQuestion& currentQuestion = m_questions[m_currentIndex];
-    currentQuestion.setUserAnswer("");
-    currentQuestion.setAnswered(false);
+    if (!m_engine.isActive()) return;
+    m_engine.clearAnswer();
+    journal(now(), SessionEventType::ClearAnswer);
+}
+
+bool QuizManager::hasNextQuestion() const
+{
+    return m_engine.hasNext();
+}
+
+void QuizManager::setSelectionStrategy(const QString& name)
+{
+    if (!m_engine.setSelectionStrategy(name.toStdString())) {
+        qDebug() << "Unknown selection strategy" << name;
+        return;
+    }
+    journal(now(), SessionEventType::Strategy, -1, name);
+}
+
+QString QuizManager::getSelectionStrategy() const
+{
+    return QString::fromStdString(m_engine.selectionStrategy());
+}
+
+QStringList QuizManager::availableSelectionStrategies()
+{
+    QStringList names;
+    for (const std::string& name : SelectionStrategyRegistry::instance().names()) {
+        names.append(QString::fromStdString(name));
+    }
+    return names;
 }
 
 bool QuizManager::isQuizActive() const
 {
-    return m_isActive;
+    return m_engine.isActive();
 }
 
 bool QuizManager::isQuizPaused() const
 {
-    return m_isPaused;
+    return m_engine.isPaused();
 }
 
 int QuizManager::getCurrentQuestionIndex() const
 {
-    return m_currentIndex;
+    return m_engine.currentQuestionIndex();
 }
 
 int QuizManager::getTotalQuestions() const
 {
-    return m_totalQuestions;
+    return m_engine.questionCount();
 }
 
 int QuizManager::getAnsweredCount() const
 {
-    return m_answeredCount;
+    return m_engine.answeredCount();
 }
 
 int QuizManager::getCorrectCount() const
 {
-    return m_correctCount;
+    return m_engine.correctCount();
 }
 
 int QuizManager::getRemainingTime() const
 {
-    return m_remainingTime;
+    return static_cast<int>((getRemainingMilliseconds() + 999) / 1000);
+}
+
+qint64 QuizManager::getRemainingMilliseconds() const
+{
+    // Computed from the deadline on demand; callers poll this when they
+    // repaint instead of being told every second
+    return remainingMillisecondsAt(now());
+}
+
+qint64 QuizManager::remainingMillisecondsAt(quint64 time) const
+{
+    if (!m_engine.isActive() || m_engine.isPaused() || !m_deadlines.isPending(m_quizDeadline)) {
+        return m_remainingMs;
+    }
+    
+    quint64 deadline = m_deadlines.deadline(m_quizDeadline);
+    return deadline > time ? static_cast<qint64>(deadline - time) : 0;
+}
+
+int QuizManager::getQuizDuration() const
+{
+    return m_initialTime;
+}
+
+void QuizManager::setQuestionTimeLimit(int seconds)
+{
+    m_questionTimeLimit = qMax(0, seconds);
+    scheduleQuestionDeadline(static_cast<qint64>(m_questionTimeLimit) * 1000);
+    armDeadlineTimer();
+}
+
+int QuizManager::getQuestionTimeLimit() const
+{
+    return m_questionTimeLimit;
+}
+
+void QuizManager::setProgressiveStart(bool enabled)
+{
+    m_progressiveStart = enabled;
+}
+
+bool QuizManager::isProgressiveStart() const
+{
+    return m_progressiveStart;
+}
+
+qint64 QuizManager::getTimeToFirstQuestionMs() const
+{
+    return m_timeToFirstQuestionMs;
+}
+
+void QuizManager::setProviderFanOut(bool enabled)
+{
+    m_providerFanOut = enabled;
+}
+
+bool QuizManager::isProviderFanOut() const
+{
+    return m_providerFanOut;
+}
+
+void QuizManager::prefetchNextQuiz()
+{
+    m_prefetcher->prefetch();
+}
+
+QuizPrefetcher::Stats QuizManager::getPrefetchStats() const
+{
+    return m_prefetcher->stats();
 }
 
 QuizQuestion QuizManager::getCurrentQuestion() const
 {
-    if (m_currentIndex < m_questions.size()) {
-        return m_questions[m_currentIndex];
+    int index = m_engine.currentQuestionIndex();
+    QuestionContentPtr current = content(index);
+    if (current) {
+        QuestionAttempt attempt = m_engine.attempt(index);
+        attempt.timeSpentMs = m_engine.timeSpentMs(index, now());
+        return QuizQuestion(current, attempt);
     }
     return QuizQuestion();
 }
 
 QList<QuizQuestion> QuizManager::getAllQuestions() const
 {
-    return m_questions;
+    QList<QuizQuestion> questions;
+    questions.reserve(m_engine.questionCount());
+    quint64 current = now();
+    for (int i = 0; i < m_engine.questionCount(); ++i) {
+        QuestionContentPtr question = content(i);
+        if (!question) break;
+        QuestionAttempt attempt = m_engine.attempt(i);
+        attempt.timeSpentMs = m_engine.timeSpentMs(i, current);
+        questions.append(QuizQuestion(question, attempt));
+    }
+    return questions;
+}
+
+QuizManager::QuestionStatus QuizManager::getQuestionStatus(int index) const
+{
+    QuestionStatus status;
+    const EngineBankPtr& bank = m_engine.bank();
+    if (!bank || index < 0 || index >= static_cast<int>(bank->size())) return status;
+    
+    const EngineQuestion& question = (*bank)[index];
+    const QuestionAttempt& attempt = m_engine.attempt(index);
+    status.difficulty = question.difficulty;
+    status.answered = attempt.answered;
+    status.correct = attempt.answered && attempt.answerIndex >= 0 &&
+                     attempt.answerIndex == question.correctIndex;
+    status.timeSpentMs = m_engine.timeSpentMs(index, now());
+    return status;
 }
 
 Difficulty QuizManager::getCurrentDifficulty() const
 {
-    return m_currentDifficulty;
+    return m_engine.currentDifficulty();
 }
 
 int QuizManager::getConsecutiveCorrect() const
 {
-    return m_consecutiveCorrect;
+    return m_engine.consecutiveCorrect();
 }
 
 int QuizManager::getConsecutiveWrong() const
 {
-    return m_consecutiveWrong;
-}
-
-void QuizManager::updateDifficulty()
-{
-    Difficulty newDifficulty = m_currentDifficulty;
-    
-    // Adaptive logic: 3 consecutive correct -> increase difficulty
-    if (m_consecutiveCorrect >= 3) {
-        switch (m_currentDifficulty) {
-            case Difficulty::Easy:
-                newDifficulty = Difficulty::Medium;
-                break;
-            case Difficulty::Medium:
-                newDifficulty = Difficulty::Hard;
-                break;
-            case Difficulty::Hard:
-                // Stay at hard
-                break;
-        }
-        m_consecutiveCorrect = 0; // Reset streak
-    }
-    
-    // 3 consecutive wrong -> decrease difficulty
-    if (m_consecutiveWrong >= 3) {
-        switch (m_currentDifficulty) {
-            case Difficulty::Hard:
-                newDifficulty = Difficulty::Medium;
-                break;
-            case Difficulty::Medium:
-                newDifficulty = Difficulty::Easy;
-                break;
-            case Difficulty::Easy:
-                // Stay at easy
-                break;
-        }
-        m_consecutiveWrong = 0; // Reset streak
-    }
-    
-    if (newDifficulty != m_currentDifficulty) {
-        m_currentDifficulty = newDifficulty;
-        emit difficultyChanged(newDifficulty);
-    }
+    return m_engine.consecutiveWrong();
 }
 
 QMap<Difficulty, int> QuizManager::getDifficultyStats() const
 {
-    return m_difficultyStats;
+    QMap<Difficulty, int> stats;
+    for (Difficulty diff : {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard}) {
+        stats[diff] = m_engine.attempts(diff);
+    }
+    return stats;
 }
 
 QMap<Difficulty, double> QuizManager::getAccuracyByDifficulty() const
 {
     QMap<Difficulty, double> accuracy;
     
-    for (auto it = m_difficultyStats.begin(); it != m_difficultyStats.end(); ++it) {
-        Difficulty diff = it.key();
-        int total = it.value();
-        int correct = m_correctByDifficulty.value(diff, 0);
+    for (Difficulty diff : {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard}) {
+        int total = m_engine.attempts(diff);
+        int correct = m_engine.correct(diff);
         
         if (total > 0) {
             accuracy[diff] = static_cast<double>(correct) / total * 100.0;
@@ -381,38 +708,49 @@ QMap<Difficulty, double> QuizManager::getAccuracyByDifficulty() const
 
 double QuizManager::getOverallAccuracy() const
 {
-    if (m_answeredCount == 0) return 0.0;
-    return static_cast<double>(m_correctCount) / m_answeredCount * 100.0;
+    return m_engine.overallAccuracy();
 }
 
 double QuizManager::getAverageTimePerQuestion() const
 {
-    if (m_timePerQuestion.isEmpty()) return 0.0;
-    
-    int totalTime = 0;
-    for (int time : m_timePerQuestion) {
-        totalTime += time;
-    }
-    
-    return static_cast<double>(totalTime) / m_timePerQuestion.size();
+    return m_engine.averageTimePerQuestion();
 }
 
-QList<int> QuizManager::getTimePerQuestion() const
+QList<double> QuizManager::getTimePerQuestion() const
 {
-    return m_timePerQuestion;
+    // Dwell time per question in seconds, including the running visit
+    QList<double> times;
+    quint64 current = now();
+    for (int i = 0; i < m_engine.questionCount(); ++i) {
+        times.append(m_engine.timeSpentMs(i, current) / 1000.0);
+    }
+    return times;
 }
 
 void QuizManager::loadCustomQuiz(const QString& name)
 {
-    m_questions = m_apiManager->loadCustomQuiz(name);
-    initializeQuestionQueue();
-    m_isActive = true;
-    m_remainingTime = m_initialTime;
-    m_timer->start();
+    // A quiz saved or loaded earlier in this process is in the bank already
+    QuestionBank& bank = QuestionBank::instance();
+    QuestionSetPtr set = bank.snapshot(QuestionBank::customName(name));
+    if (set) {
+        beginSession(set);
+        return;
+    }
     
-    emit quizStarted();
-    emit questionChanged(0);
-    emit progressUpdated(0, m_totalQuestions);
+    // A quiz saved as a pack is played straight from the mapped file
+    QSharedPointer<const QuestionPack> pack = m_apiManager->openCustomPack(name);
+    if (pack) {
+        beginSession(pack);
+        return;
+    }
+    
+    // Anything else is read once and published for later sessions
+    QList<QuizQuestion> questions = m_apiManager->loadCustomQuiz(name);
+    if (questions.isEmpty()) {
+        beginSession(questions);
+        return;
+    }
+    beginSession(bank.publish(QuestionBank::customName(name), questions));
 }
 
 void QuizManager::createCustomQuiz(const QString& name, const QList<QuizQuestion>& questions)
@@ -420,409 +758,414 @@ void QuizManager::createCustomQuiz(const QString& name, const QList<QuizQuestion
     m_apiManager->saveCustomQuiz(name, questions);
 }
 
-void QuizManager::updateTimer()
+void QuizManager::setCustomQuizFormat(QuizFileFormat format)
 {
-    if (!m_isActive || m_isPaused) return;
-    
-    m_remainingTime--;
-    emit timeUpdated(m_remainingTime);
-    
-    if (m_remainingTime <= 0) {
-        finishQuiz();
-    }
+    m_apiManager->setCustomQuizFormat(format);
 }
 
-void QuizManager::onQuestionsFetched(const QList<QuizQuestion>& questions)
+QuizFileFormat QuizManager::getCustomQuizFormat() const
 {
-    m_questions = questions;
-    m_totalQuestions = m_questions.size();
-    m_timePerQuestion.resize(m_totalQuestions);
-    
-    // Initialize DSA structures for intelligent question selection
-    initializeQuestionQueue();
-    
-    m_isActive = true;
-    m_remainingTime = m_initialTime;
-    m_timer->start();
-    
-    emit quizStarted();
-    emit questionChanged(0);
-    emit progressUpdated(0, m_totalQuestions);
+    return m_apiManager->customQuizFormat();
 }
 
-void QuizManager::onApiError(const QString& error)
+QList<QJsonObject> QuizManager::getRecentResults(int count) const
 {
-    // Handle API error gracefully - fallback to local questions
-    // In a production environment, you might want to log this error
-    m_questions = m_apiManager->getCppDSAQuestions();
-    initializeQuestionQueue();
-    m_isActive = true;
-    m_remainingTime = m_initialTime;
-    m_timer->start();
-    
-    emit quizStarted();
-    emit questionChanged(0);
-    emit progressUpdated(0, m_totalQuestions);
+    m_persistence->flush();
+    return m_resultsLog.last(count);
 }
 
-void QuizManager::loadQuizResults()
+QList<QJsonObject> QuizManager::getResultsBetween(const QDateTime& from, const QDateTime& to) const
 {
-    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir().mkpath(dataPath);
-    QString filePath = dataPath + "/quiz_results.json";
-    
-    QFile file(filePath);
-    if (file.open(QIODevice::ReadOnly)) {
-        QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-        QJsonObject results = doc.object();
-        
-        // Load analytics data
-        if (results.contains("difficultyStats")) {
-            QJsonObject stats = results["difficultyStats"].toObject();
-            m_difficultyStats[Difficulty::Easy] = stats["easy"].toInt();
-            m_difficultyStats[Difficulty::Medium] = stats["medium"].toInt();
-            m_difficultyStats[Difficulty::Hard] = stats["hard"].toInt();
-        }
-    }
+    m_persistence->flush();
+    return m_resultsLog.between(from, to);
 }
 
-// ========== DSA ALGORITHMS FOR INTELLIGENT QUESTION SELECTION ==========
+bool QuizManager::hasRecoverableSession() const
+{
+    return !m_engine.isActive() && QFile::exists(journalPath());
+}
 
-void QuizManager::buildQuestionPriorityQueue()
+bool QuizManager::recoverSession()
 {
-    m_questionQueue = std::priority_queue<QuestionPriority>(); // Clear by creating new empty queue
-    m_questionsByDifficulty.clear();
-    m_questionWeights.clear();
+    if (m_engine.isActive()) return false;
+    
+    QFile file(journalPath());
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    QByteArray bytes = file.readAll();
+    file.close();
+    
+    // A torn last batch is dropped; everything before it is kept
+    SessionJournalReader reader;
+    if (!reader.read(reinterpret_cast<const std::uint8_t*>(bytes.constData()),
+                     static_cast<std::size_t>(bytes.size()))) {
+        qDebug() << "Session journal is unreadable, discarding it";
+        discardRecoverableSession();
+        return false;
+    }
     
-    // Categorize questions by difficulty using Hash Map (O(n))
-    for (int i = 0; i < m_questions.size(); ++i) {
-        Difficulty diff = m_questions[i].getDifficulty();
-        m_questionsByDifficulty[diff].append(i);
-        
-        // Initialize weights using weighted random selection
-        double baseWeight = 1.0;
-        switch (diff) {
-            case Difficulty::Easy: baseWeight = 1.0; break;
-            case Difficulty::Medium: baseWeight = 1.5; break;
-            case Difficulty::Hard: baseWeight = 2.0; break;
+    // The questions come back from the journal itself, from the pack it
+    // refers to if that is still the same file, or from the published set
+    // it names if that still has the same bank
+    const SessionStart& start = reader.start();
+    QByteArray content = QByteArray::fromStdString(start.content);
+    QSharedPointer<const QuestionPack> pack = decodePackReference(content);
+    QuestionSetPtr referenced;
+    QList<QuestionContentPtr> contents;
+    QString setName;
+    if (!pack && decodeSetReference(content, setName)) {
+        if (!resolveSetReference(setName, start.bank, referenced, pack)) {
+            qDebug() << "Question set of the recovered session is gone or has changed:" << setName;
+            discardRecoverableSession();
+            return false;
         }
-        m_questionWeights[i] = baseWeight;
+        if (referenced) contents = referenced->contents;
+    } else if (!pack) {
+        contents = decodeContents(content);
+    }
+    int questionCount = pack ? pack->count() : contents.size();
+    if (questionCount != static_cast<int>(start.bank.size())) {
+        qDebug() << "Session journal questions do not match its bank, discarding it";
+        discardRecoverableSession();
+        return false;
     }
     
-    // Build priority queue using Heap Sort algorithm (O(n log n))
-    for (int i = 0; i < m_questions.size(); ++i) {
-        QuestionPriority qp;
-        qp.questionIndex = i;
-        qp.priority = m_questionWeights[i];
-        qp.difficulty = m_questions[i].getDifficulty();
-        qp.timeSpent = 0;
-        qp.answered = false;
-        
-        m_questionQueue.push(qp);
+    // Rebuild the engine by replaying the session on it, stopping at the
+    // first event it does not reproduce
+    resetQuiz();
+    SessionReplayState state = replaySession(m_engine, start,
+                                             std::make_shared<EngineBank>(start.bank),
+                                             reader.events());
+    if (!m_engine.isActive()) {
+        m_engine.reset();
+        discardRecoverableSession();
+        return false;
     }
     
-    // Initialize difficulty weights for adaptive selection
-    m_difficultyWeights[Difficulty::Easy] = 0.4;
-    m_difficultyWeights[Difficulty::Medium] = 0.4;
-    m_difficultyWeights[Difficulty::Hard] = 0.2;
+    // A quiz that grew while it ran gets the questions each replayed
+    // extension added
+    for (int i = 0; i < state.applied && !pack; ++i) {
+        const SessionEvent& event = reader.events()[i];
+        if (event.type == SessionEventType::Extend) {
+            contents += decodeContents(QByteArray::fromStdString(event.content));
+        }
+    }
+    if (!pack && contents.size() != m_engine.questionCount()) {
+        qDebug() << "Session journal questions do not match its bank, discarding it";
+        m_engine.reset();
+        discardRecoverableSession();
+        return false;
+    }
+    if (pack) {
+        m_set.reset();
+    } else if (referenced && referenced->count() == contents.size()) {
+        m_set = referenced;
+    } else {
+        m_set = QuestionBank::makeSet("recovered", contents);
+    }
+    m_pack = pack;
+    m_contentCache.clear();
+    m_questionTimeLimit = static_cast<int>(start.questionLimitMs / 1000);
+    
+    // The time between the last journaled event and the crash is lost, so
+    // the quiz comes back paused as of that event
+    bool wasPaused = m_engine.isPaused();
+    m_engine.pause(state.lastTime);
+    m_remainingMs = qMax<qint64>(0, static_cast<qint64>(start.quizDurationMs) - static_cast<qint64>(state.activeMs));
+    m_questionRemainingMs = start.questionLimitMs > 0
+        ? qMax<qint64>(0, static_cast<qint64>(start.questionLimitMs) - static_cast<qint64>(state.visitMs))
+        : 0;
+    
+    // Carry the engine clock on from there, never backwards
+    quint64 current = now();
+    quint64 resumeAt = qMax(state.lastTime, current);
+    m_clockOffset += static_cast<qint64>(resumeAt - current);
+    
+    // Rewrite the journal with what was replayed, so a second crash
+    // recovers the same state
+    openJournal(start);
+    for (int i = 0; i < state.applied; ++i) {
+        m_journal.append(reader.events()[i]);
+    }
+    if (!wasPaused) {
+        SessionEvent pause;
+        pause.type = SessionEventType::Pause;
+        pause.time = state.lastTime;
+        m_journal.append(pause);
+    }
+    flushJournal();
+    
+    int index = m_engine.currentQuestionIndex();
+    emit quizStarted();
+    emit questionChanged(index);
+    emit progressUpdated(m_engine.answeredCount(), m_engine.questionCount());
+    emit streakUpdated(m_engine.consecutiveCorrect(), m_engine.consecutiveWrong());
+    emit difficultyChanged(m_engine.currentDifficulty());
+    emit timeUpdated(getRemainingTime());
+    emit quizPaused();
+    return true;
 }
 
-void QuizManager::updateQuestionWeights()
+void QuizManager::discardRecoverableSession()
 {
-    // Update weights based on performance using Dynamic Programming approach
-    for (int i = 0; i < m_questions.size(); ++i) {
-        if (m_answeredQuestions.contains(i)) continue;
-        
-        double newWeight = m_questionWeights[i];
-        Difficulty diff = m_questions[i].getDifficulty();
-        
-        // Performance-based weight adjustment
-        double accuracy = m_accuracyByDifficulty.value(diff, 0.5);
-        double avgTime = m_averageTimeByDifficulty.value(diff, 60.0);
-        
-        // Adaptive weight calculation using exponential backoff
-        if (accuracy < 0.3) {
-            newWeight *= 0.8; // Reduce weight for difficult questions
-        } else if (accuracy > 0.7) {
-            newWeight *= 1.2; // Increase weight for easier questions
-        }
-        
-        // Time-based adjustment
-        if (avgTime > 120) {
-            newWeight *= 0.9; // Reduce weight for time-consuming questions
-        }
-        
-        m_questionWeights[i] = newWeight;
-    }
+    if (m_engine.isActive()) return;
+    QFile::remove(journalPath());
 }
 
-void QuizManager::adaptiveQuestionSelection()
+void QuizManager::openJournal(const SessionStart& start)
 {
-    // Algorithm: Adaptive Selection using Multi-Criteria Decision Making
+    discardJournal();
     
-    if (m_questionQueue.empty()) {
-        buildQuestionPriorityQueue();
+    QString filePath = journalPath();
+    QDir().mkpath(QFileInfo(filePath).path());
+    m_journalFile.setFileName(filePath);
+    if (!m_journalFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Cannot open session journal" << filePath;
+        return;
     }
     
-    // Update weights based on current performance
-    updateQuestionWeights();
-    
-    // Select question using weighted random selection
-    weightedRandomSelection();
+    // The start record goes out at once; events follow in batches
+    m_journal.start(start);
+    flushJournal();
 }
 
-void QuizManager::weightedRandomSelection()
+void QuizManager::journal(quint64 time, SessionEventType type, qint32 value, const QString& text)
 {
-    // Algorithm: Weighted Random Selection using Reservoir Sampling
-    
-    if (m_questionsByDifficulty.isEmpty()) {
-        buildQuestionPriorityQueue();
-    }
-    
-    // Calculate total weight
-    double totalWeight = 0.0;
-    QList<int> availableQuestions;
-    
-    for (int i = 0; i < m_questions.size(); ++i) {
-        if (!m_answeredQuestions.contains(i)) {
-            totalWeight += m_questionWeights[i];
-            availableQuestions.append(i);
-        }
-    }
-    
-    if (availableQuestions.isEmpty()) return;
-    
-    // Reservoir sampling for weighted random selection
-    double randomValue = QRandomGenerator::global()->bounded(totalWeight);
-    double cumulativeWeight = 0.0;
-    int selectedIndex = -1;
-    
-    for (int questionIndex : availableQuestions) {
-        cumulativeWeight += m_questionWeights[questionIndex];
-        if (cumulativeWeight >= randomValue) {
-            selectedIndex = questionIndex;
-            break;
-        }
-    }
-    
-    if (selectedIndex != -1) {
-        m_currentIndex = selectedIndex;
-        emit questionChanged(m_currentIndex);
-    }
+    SessionEvent event;
+    event.type = type;
+    event.time = time;
+    event.value = value;
+    event.text = text.toStdString();
+    journal(event);
 }
 
-void QuizManager::difficultyBasedSelection()
+void QuizManager::journal(const SessionEvent& event)
 {
-    // Algorithm: Difficulty-Based Selection using Priority Queue
+    if (!m_journalFile.isOpen()) return;
     
-    // Determine target difficulty based on performance
-    Difficulty targetDifficulty = m_currentDifficulty;
+    m_journal.append(event);
     
-    // Adaptive difficulty adjustment using sliding window
-    if (m_consecutiveCorrect >= 3) {
-        // Increase difficulty
-        switch (targetDifficulty) {
-            case Difficulty::Easy: targetDifficulty = Difficulty::Medium; break;
-            case Difficulty::Medium: targetDifficulty = Difficulty::Hard; break;
-            case Difficulty::Hard: targetDifficulty = Difficulty::Hard; break;
-        }
-    } else if (m_consecutiveWrong >= 2) {
-        // Decrease difficulty
-        switch (targetDifficulty) {
-            case Difficulty::Easy: targetDifficulty = Difficulty::Easy; break;
-            case Difficulty::Medium: targetDifficulty = Difficulty::Easy; break;
-            case Difficulty::Hard: targetDifficulty = Difficulty::Medium; break;
-        }
+    if (m_journal.pendingEvents() >= JournalBatchEvents) {
+        flushJournal();
+    } else if (!m_journalTimer->isActive()) {
+        m_journalTimer->start(JournalFlushDelayMs);
     }
+}
+
+void QuizManager::flushJournal()
+{
+    m_journalTimer->stop();
+    if (!m_journalFile.isOpen() || !m_journal.hasPending()) return;
     
-    // Select question from target difficulty using Binary Search
-    QList<int>& questions = m_questionsByDifficulty[targetDifficulty];
-    if (!questions.isEmpty()) {
-        // Find unasked question using Set lookup (O(1))
-        for (int questionIndex : questions) {
-            if (!m_answeredQuestions.contains(questionIndex)) {
-                m_currentIndex = questionIndex;
-                emit questionChanged(m_currentIndex);
-                return;
-            }
-        }
+    std::vector<std::uint8_t> bytes = m_journal.takePending();
+    m_journalFile.write(reinterpret_cast<const char*>(bytes.data()), static_cast<qint64>(bytes.size()));
+    m_journalFile.flush();
+}
+
+void QuizManager::discardJournal()
+{
+    m_journalTimer->stop();
+    m_journal = SessionJournalWriter();
+    if (m_journalFile.isOpen()) {
+        m_journalFile.remove();
     }
-    
-    // Fallback to weighted selection
-    weightedRandomSelection();
 }
 
-void QuizManager::performanceBasedSelection()
+QString QuizManager::journalPath()
 {
-    // Algorithm: Performance-Based Selection using Dynamic Programming
-    
-    // Calculate performance metrics
-    QMap<Difficulty, double> performanceScores;
-    
-    for (auto it = m_accuracyByDifficulty.begin(); it != m_accuracyByDifficulty.end(); ++it) {
-        Difficulty diff = it.key();
-        double accuracy = it.value();
-        double avgTime = m_averageTimeByDifficulty.value(diff, 60.0);
-        
-        // Performance score calculation using weighted average
-        double timeScore = 1.0 / (1.0 + avgTime / 60.0); // Normalize time
-        double performanceScore = 0.7 * accuracy + 0.3 * timeScore;
-        performanceScores[diff] = performanceScore;
+    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return QDir(dataPath).filePath("session.journal");
+}
+
+QByteArray QuizManager::encodeContents(const QList<QuestionContentPtr>& contents)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << static_cast<qint32>(contents.size());
+    for (const QuestionContentPtr& content : contents) {
+        stream << content->question << content->options << content->correctAnswer
+               << static_cast<qint32>(content->difficulty) << static_cast<qint32>(content->type);
     }
-    
-    // Select difficulty with best performance score
-    Difficulty bestDifficulty = Difficulty::Easy;
-    double bestScore = performanceScores.value(Difficulty::Easy, 0.0);
-    
-    for (auto it = performanceScores.begin(); it != performanceScores.end(); ++it) {
-        if (it.value() > bestScore) {
-            bestScore = it.value();
-            bestDifficulty = it.key();
-        }
+    return data;
+}
+
+QList<QuestionContentPtr> QuizManager::decodeContents(const QByteArray& data)
+{
+    QList<QuestionContentPtr> contents;
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+    qint32 count = 0;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString question;
+        QStringList options;
+        QString correctAnswer;
+        qint32 difficulty = 0;
+        qint32 type = 0;
+        stream >> question >> options >> correctAnswer >> difficulty >> type;
+        contents.append(QuizQuestion::makeContent(question, options, correctAnswer,
+                                                  static_cast<Difficulty>(difficulty),
+                                                  static_cast<QuestionType>(type)));
     }
-    
-    // Select question from best performing difficulty
-    QList<int>& questions = m_questionsByDifficulty[bestDifficulty];
-    for (int questionIndex : questions) {
-        if (!m_answeredQuestions.contains(questionIndex)) {
-            m_currentIndex = questionIndex;
-            emit questionChanged(m_currentIndex);
-            return;
-        }
+    if (stream.status() != QDataStream::Ok) {
+        contents.clear();
     }
-    
-    // Fallback
-    weightedRandomSelection();
+    return contents;
 }
 
-void QuizManager::timeBasedSelection()
+QByteArray QuizManager::encodePackReference(const QuestionPack& pack)
 {
-    // Algorithm: Time-Based Selection using Priority Queue
-    
-    // Calculate time-based priorities
-    QList<QuestionPriority> timePriorities;
-    
-    for (int i = 0; i < m_questions.size(); ++i) {
-        if (m_answeredQuestions.contains(i)) continue;
-        
-        QuestionPriority qp;
-        qp.questionIndex = i;
-        qp.difficulty = m_questions[i].getDifficulty();
-        qp.timeSpent = 0;
-        qp.answered = false;
-        
-        // Time-based priority calculation
-        double avgTime = m_averageTimeByDifficulty.value(qp.difficulty, 60.0);
-        double timePriority = 1.0 / (1.0 + avgTime / 60.0);
-        
-        // Combine with difficulty weight
-        qp.priority = timePriority * m_difficultyWeights.value(qp.difficulty, 1.0);
-        
-        timePriorities.append(qp);
+    // A negative count marks a reference: path and checksum of the pack
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << static_cast<qint32>(-1) << pack.path() << pack.checksum();
+    return data;
+}
+
+QByteArray QuizManager::encodeSetReference(const QuestionSet& set)
+{
+    // A count of -2 marks a published set: its name and version
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << static_cast<qint32>(-2) << set.name << set.version;
+    return data;
+}
+
+bool QuizManager::decodeSetReference(const QByteArray& data, QString& name)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+    qint32 count = 0;
+    quint64 version = 0;
+    stream >> count;
+    if (count != -2) return false;
+    stream >> name >> version;
+    return stream.status() == QDataStream::Ok;
+}
+
+bool QuizManager::resolveSetReference(const QString& name, const EngineBank& bank,
+                                      QuestionSetPtr& set, QSharedPointer<const QuestionPack>& pack)
+{
+    // Versions are numbered per process, so what decides is that the set
+    // found still has the journaled bank, entry for entry
+    auto matches = [&bank](const EngineBank& other) {
+        if (other.size() != bank.size()) return false;
+        for (std::size_t i = 0; i < bank.size(); ++i) {
+            if (other[i].difficulty != bank[i].difficulty || other[i].correctIndex != bank[i].correctIndex) {
+                return false;
+            }
+        }
+        return true;
+    };
+    
+    QuestionBank& questionBank = QuestionBank::instance();
+    set = questionBank.snapshot(name);
+    if (set && matches(*set->bank)) return true;
+    set.reset();
+    
+    // A custom quiz is not in the bank after a restart until it is loaded
+    QString customPrefix = QuestionBank::customName(QString());
+    if (!name.startsWith(customPrefix)) return false;
+    QString quizName = name.mid(customPrefix.size());
+    
+    pack = m_apiManager->openCustomPack(quizName);
+    if (pack) {
+        EngineBankPtr packBank = pack->engineBank();
+        if (packBank && matches(*packBank)) return true;
+        pack.reset();
+        return false;
     }
     
-    if (!timePriorities.isEmpty()) {
-        // Sort by priority (Heap Sort)
-        std::sort(timePriorities.begin(), timePriorities.end());
-        
-        // Select highest priority question
-        m_currentIndex = timePriorities.last().questionIndex;
-        emit questionChanged(m_currentIndex);
-    }
+    QList<QuizQuestion> questions = m_apiManager->loadCustomQuiz(quizName);
+    if (questions.isEmpty()) return false;
+    set = questionBank.publish(name, questions);
+    if (matches(*set->bank)) return true;
+    set.reset();
+    return false;
 }
 
-void QuizManager::selectNextQuestion()
+QSharedPointer<const QuestionPack> QuizManager::decodePackReference(const QByteArray& data)
 {
-    // Main selection algorithm using multiple DSA approaches
-    
-    // Update performance metrics
-    updateStreaks(false); // Update without changing streaks
-    
-    // Choose selection strategy based on quiz progress
-    int progress = (m_answeredCount * 100) / m_totalQuestions;
-    
-    if (progress < 30) {
-        // Early stage: Use difficulty-based selection
-        difficultyBasedSelection();
-    } else if (progress < 70) {
-        // Middle stage: Use adaptive selection
-        adaptiveQuestionSelection();
-    } else {
-        // Late stage: Use performance-based selection
-        performanceBasedSelection();
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+    qint32 count = 0;
+    QString path;
+    quint32 checksum = 0;
+    stream >> count;
+    if (count != -1) return QSharedPointer<const QuestionPack>();
+    stream >> path >> checksum;
+    
+    QSharedPointer<QuestionPack> pack = QSharedPointer<QuestionPack>::create();
+    if (stream.status() != QDataStream::Ok || !pack->open(path) || pack->checksum() != checksum) {
+        qDebug() << "Question pack of the recovered session is gone or has changed:" << path;
+        return QSharedPointer<const QuestionPack>();
     }
+    return pack;
 }
 
-void QuizManager::initializeQuestionQueue()
+void QuizManager::onQuestionsFetched(const QList<QuizQuestion>& questions)
 {
-    // Initialize all DSA structures
-    buildQuestionPriorityQueue();
-    
-    // Set initial difficulty weights
-    m_difficultyWeights[Difficulty::Easy] = 0.4;
-    m_difficultyWeights[Difficulty::Medium] = 0.4;
-    m_difficultyWeights[Difficulty::Hard] = 0.2;
-    
-    // Initialize performance tracking
-    m_accuracyByDifficulty[Difficulty::Easy] = 0.5;
-    m_accuracyByDifficulty[Difficulty::Medium] = 0.5;
-    m_accuracyByDifficulty[Difficulty::Hard] = 0.5;
-    
-    m_averageTimeByDifficulty[Difficulty::Easy] = 60.0;
-    m_averageTimeByDifficulty[Difficulty::Medium] = 90.0;
-    m_averageTimeByDifficulty[Difficulty::Hard] = 120.0;
-    
-    m_attemptsByDifficulty[Difficulty::Easy] = 0;
-    m_attemptsByDifficulty[Difficulty::Medium] = 0;
-    m_attemptsByDifficulty[Difficulty::Hard] = 0;
+    // A progressive start takes its questions from the stream only
+    if (m_stream) return;
+    m_fetchRequest = 0;
+    beginSession(questions);
 }
 
-void QuizManager::updatePerformanceMetrics(Difficulty difficulty, bool isCorrect, int timeSpent)
+void QuizManager::onStreamedQuestions()
 {
-    // Update difficulty statistics
-    m_difficultyStats[difficulty]++;
-    m_attemptsByDifficulty[difficulty]++;
-    
-    if (isCorrect) {
-        m_correctByDifficulty[difficulty]++;
+    if (!m_stream) return;
+    QList<QuestionContentPtr> added = m_stream->takeAvailable();
+    if (added.isEmpty()) return;
+    
+    if (!m_set) {
+        // The first questions in start the quiz
+        beginSession(QuestionBank::makeSet("session", added));
+    } else if (m_engine.isActive()) {
+        extendSession(added);
     }
-    
-    // Calculate accuracy by difficulty using rolling average
-    int attempts = m_attemptsByDifficulty[difficulty];
-    int correct = m_correctByDifficulty[difficulty];
-    
-    if (attempts > 0) {
-        double accuracy = static_cast<double>(correct) / attempts;
-        m_accuracyByDifficulty[difficulty] = accuracy;
-    }
-    
-    // Update average time by difficulty using exponential moving average
-    double currentAvgTime = m_averageTimeByDifficulty.value(difficulty, 60.0);
-    double alpha = 0.3; // Smoothing factor
-    double newAvgTime = alpha * timeSpent + (1 - alpha) * currentAvgTime;
-    m_averageTimeByDifficulty[difficulty] = newAvgTime;
 }
 
-void QuizManager::adjustDifficulty()
+void QuizManager::onRequestFailed(int requestId, const QString& error)
 {
-    updateDifficulty();
+    // Failures of other callers' requests, such as a prefetch, are theirs
+    if (requestId != m_fetchRequest) return;
+    m_fetchRequest = 0;
+    if (m_stream) {
+        // A streamed quiz that is running keeps what arrived, and the fetch
+        // tops it up; one still waiting for its first question gives up on
+        // the stream
+        if (m_set) return;
+        m_stream->cancel();
+        disconnect(m_stream.data(), nullptr, this, nullptr);
+        m_stream.reset();
+    }
     
-    // After difficulty change, we could select the next question from the new difficulty
-    // This would make the adaptive system more responsive
-    // For now, we'll keep the current approach but this is where we'd implement
-    // dynamic question selection based on the new difficulty
+    // Handle API error gracefully - fallback to local questions
+    // In a production environment, you might want to log this error
+    beginSession(QuestionBank::instance().snapshot("cpp_dsa"));
 }
 
-void QuizManager::updateStreaks(bool isCorrect)
+void QuizManager::loadQuizResults()
 {
-    // Streaks are already updated in answerQuestion
-    // This method can be used for additional streak-based logic
+    // Analytics carry over from the most recent result
+    QList<QJsonObject> latest = getRecentResults(1);
+    if (latest.isEmpty()) return;
+    
+    QJsonObject results = latest.first();
+    if (results.contains("difficultyStats")) {
+        QJsonObject stats = results["difficultyStats"].toObject();
+        m_engine.setAttempts(Difficulty::Easy, stats["easy"].toInt());
+        m_engine.setAttempts(Difficulty::Medium, stats["medium"].toInt());
+        m_engine.setAttempts(Difficulty::Hard, stats["hard"].toInt());
+    }
 }
 
 QList<QuizQuestion> QuizManager::getQuestionsForDifficulty(Difficulty difficulty)
 {
     QList<QuizQuestion> filtered;
-    for (const QuizQuestion& question : m_questions) {
+    for (const QuizQuestion& question : getAllQuestions()) {
         if (question.getDifficulty() == difficulty) {
             filtered.append(question);
         }
@@ -838,32 +1181,34 @@ void QuizManager::calculateStats()
 
 void QuizManager::saveQuizResults()
 {
-    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir dir(dataPath);
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
-    
-    QString filePath = dir.filePath("quiz_results.json");
-    QFile file(filePath);
-    
-    if (file.open(QIODevice::WriteOnly)) {
-        QJsonObject results;
-        results["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-        results["totalQuestions"] = m_totalQuestions;
-        results["answeredCount"] = m_answeredCount;
-        results["correctCount"] = m_correctCount;
-        results["overallAccuracy"] = getOverallAccuracy();
-        results["averageTime"] = getAverageTimePerQuestion();
-        
-        QJsonArray questionsArray;
-        for (const QuizQuestion& question : m_questions) {
-            questionsArray.append(question.toJson());
-        }
-        results["questions"] = questionsArray;
-        
-        QJsonDocument doc(results);
-        file.write(doc.toJson());
-        file.close();
+    // One compact record per finished quiz, appended to the history on the
+    // persistence thread. The question text is not repeated; each question
+    // keeps its outcome.
+    QJsonObject results;
+    results["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    results["totalQuestions"] = m_engine.questionCount();
+    results["answeredCount"] = m_engine.answeredCount();
+    results["correctCount"] = m_engine.correctCount();
+    results["overallAccuracy"] = getOverallAccuracy();
+    results["averageTime"] = getAverageTimePerQuestion();
+    
+    QJsonObject stats;
+    stats["easy"] = m_engine.attempts(Difficulty::Easy);
+    stats["medium"] = m_engine.attempts(Difficulty::Medium);
+    stats["hard"] = m_engine.attempts(Difficulty::Hard);
+    results["difficultyStats"] = stats;
+    
+    QJsonArray questionsArray;
+    for (int i = 0; i < m_engine.questionCount(); ++i) {
+        QuestionStatus status = getQuestionStatus(i);
+        QJsonObject outcome;
+        outcome["difficulty"] = QuizQuestion::difficultyToString(status.difficulty);
+        outcome["answered"] = status.answered;
+        outcome["correct"] = status.correct;
+        outcome["timeSpentMs"] = static_cast<qint64>(status.timeSpentMs);
+        questionsArray.append(outcome);
     }
-} 
\ No newline at end of file
+    results["questions"] = questionsArray;
+    
+    m_persistence->appendResult(&m_resultsLog, results);
+}
\ No newline at end of file
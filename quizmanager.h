@@ -3,6 +3,8 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QQueue>
 #include <QStack>
 #include <QMap>
@@ -11,11 +13,22 @@
 #include <QPair>
 #include <QVector>
 #include <QHash>
-#include <queue>
 #include <QRandomGenerator>
 #include "quizquestion.h"
 #include "apimanager.h"
+#include "questionpack.h"
+#include "questionbank.h"
+#include "questionstream.h"
+#include "quizprefetcher.h"
+#include "resultslog.h"
+#include "persistenceservice.h"
+#include "quizengine.h"
+#include "timerwheel.h"
+#include "sessionjournal.h"
 
+// Qt front end of a QuizEngine: owns the quiz deadlines and the question
+// text, maps answers to option indices and turns engine results into
+// signals. All quiz logic lives in the engine.
 class QuizManager : public QObject
 {
     Q_OBJECT
@@ -30,6 +43,10 @@ public:
     void resumeQuiz();
     void finishQuiz();
     void resetQuiz();
+    // Stops the fetch for the current quiz, if one is still running. A
+    // quiz it has not started yet never starts; one it is growing keeps
+    // what it has.
+    void cancelFetch();
     
     // Question Navigation
     void nextQuestion();
@@ -37,6 +54,12 @@ public:
     void goToQuestion(int index);
     void answerQuestion(const QString& answer);
     void clearAnswer();
+    bool hasNextQuestion() const;
+    
+    // Question selection strategy, chosen per quiz by registry name
+    void setSelectionStrategy(const QString& name);
+    QString getSelectionStrategy() const;
+    static QStringList availableSelectionStrategies();
     
     // Quiz State
     bool isQuizActive() const;
@@ -46,25 +69,70 @@ public:
     int getAnsweredCount() const;
     int getCorrectCount() const;
     int getRemainingTime() const;
+    qint64 getRemainingMilliseconds() const;
+    int getQuizDuration() const;
     QuizQuestion getCurrentQuestion() const;
-    QList<QuizQuestion> getAllQuestions() const;
+    QList<QuizQuestion> getAllQuestions() const; // decodes every question
+    
+    // What the engine knows of a question, without decoding its text
+    struct QuestionStatus {
+        Difficulty difficulty = Difficulty::Easy;
+        bool answered = false;
+        bool correct = false;
+        quint32 timeSpentMs = 0;
+    };
+    QuestionStatus getQuestionStatus(int index) const;
     
     // Adaptive Logic
     Difficulty getCurrentDifficulty() const;
     int getConsecutiveCorrect() const;
     int getConsecutiveWrong() const;
-    void updateDifficulty();
     
     // Analytics
     QMap<Difficulty, int> getDifficultyStats() const;
     QMap<Difficulty, double> getAccuracyByDifficulty() const;
     double getOverallAccuracy() const;
     double getAverageTimePerQuestion() const;
-    QList<int> getTimePerQuestion() const;
+    QList<double> getTimePerQuestion() const; // seconds
+    
+    // Per-question time limit in seconds, 0 for none
+    void setQuestionTimeLimit(int seconds);
+    int getQuestionTimeLimit() const;
+    
+    // Progressive start: a fetched quiz starts on its first question and
+    // the rest join the running session as they are parsed. On by default.
+    void setProgressiveStart(bool enabled);
+    bool isProgressiveStart() const;
+    // From startQuiz() to the first question shown, for the last quiz
+    // started; -1 before any
+    qint64 getTimeToFirstQuestionMs() const;
+    // The default quiz from every configured provider at once, merged
+    // under one deadline, instead of from NewsAPI alone. Off by default.
+    void setProviderFanOut(bool enabled);
+    bool isProviderFanOut() const;
+    
+    // Background prefetch of the next quiz's questions. Runs by itself
+    // once a quiz starts; the analytics screen asks for it too.
+    void prefetchNextQuiz();
+    QuizPrefetcher::Stats getPrefetchStats() const;
     
     // Custom Quiz
     void loadCustomQuiz(const QString& name);
     void createCustomQuiz(const QString& name, const QList<QuizQuestion>& questions);
+    // Format new custom quizzes are saved in; question packs by default,
+    // so they are played from the mapped file instead of parsed
+    void setCustomQuizFormat(QuizFileFormat format);
+    QuizFileFormat getCustomQuizFormat() const;
+    
+    // Results history, one record per finished quiz, oldest first
+    QList<QJsonObject> getRecentResults(int count) const;
+    QList<QJsonObject> getResultsBetween(const QDateTime& from, const QDateTime& to) const;
+    
+    // Crash recovery: a quiz the last run left unfinished is rebuilt from
+    // its session journal and comes back paused
+    bool hasRecoverableSession() const;
+    bool recoverSession();
+    void discardRecoverableSession();
 
 signals:
     void quizStarted();
@@ -74,94 +142,112 @@ signals:
     void questionChanged(int index);
     void answerSubmitted(int index, bool correct);
     void timeUpdated(int remainingSeconds);
+    void questionTimeUp(int index);
     void difficultyChanged(Difficulty newDifficulty);
     void progressUpdated(int answered, int total);
     void streakUpdated(int consecutiveCorrect, int consecutiveWrong);
+    void questionsAdded(int total); // the running quiz grew
 
 private slots:
-    void updateTimer();
+    void processDeadlines();
+    void flushJournal();
     void onQuestionsFetched(const QList<QuizQuestion>& questions);
-    void onApiError(const QString& error);
+    void onStreamedQuestions();
+    void onRequestFailed(int requestId, const QString& error);
 
 private:
-    // Quiz State
-    bool m_isActive;
-    bool m_isPaused;
-    int m_currentIndex;
-    int m_totalQuestions;
-    int m_answeredCount;
-    int m_correctCount;
-    int m_remainingTime;
-    
-    // Questions
-    QList<QuizQuestion> m_questions;
-    QStack<int> m_questionHistory;
-    
-    // Adaptive Logic
-    Difficulty m_currentDifficulty;
-    int m_consecutiveCorrect;
-    int m_consecutiveWrong;
-    int m_easyCorrect;
-    int m_mediumCorrect;
-    int m_hardCorrect;
-    
-    // Timer
-    QTimer* m_timer;
+    // Engine holding quiz state, selection, scoring and adaptive difficulty
+    QuizEngine m_engine;
+    
+    // Snapshot of the question set being played, text and engine bank,
+    // held for the whole quiz whatever is published meanwhile. A quiz
+    // played from a question pack has none; its text is decoded from the
+    // pack as each question is shown.
+    QuestionSetPtr m_set;
+    QSharedPointer<const QuestionPack> m_pack;
+    // m_set once the quiz has grown: a copy only this session holds, so
+    // streamed questions are appended to it and its bank in place
+    std::shared_ptr<QuestionSet> m_ownedSet;
+    std::shared_ptr<EngineBank> m_ownedBank;
+    // The last few questions decoded from the pack, most recent first; the
+    // shown question is asked for several times whenever it changes
+    static constexpr int ContentCacheSize = 4;
+    mutable QList<QPair<int, QuestionContentPtr>> m_contentCache;
+    
+    // Timing: quiz and question deadlines on a monotonic clock, kept in a
+    // timing wheel. One single-shot timer is armed for the earliest
+    // deadline; nothing ticks while the quiz runs.
+    enum DeadlineKind : quint64 {
+        QuizDeadline = 1,
+        QuestionDeadline = 2
+    };
+    QElapsedTimer m_clock;
+    TimerWheel m_deadlines;
+    TimerWheel::TimerId m_quizDeadline;
+    TimerWheel::TimerId m_questionDeadline;
+    QTimer* m_deadlineTimer;
+    qint64 m_remainingMs;         // quiz time left while paused or stopped
+    qint64 m_questionRemainingMs; // question time left while paused
     int m_initialTime; // in seconds
+    int m_questionTimeLimit; // in seconds, 0 for none
+    qint64 m_clockOffset; // keeps engine time continuous across a recovery
+    
+    // Session journal: every event that changes engine state is appended
+    // in memory and written out in batches, when enough have built up or
+    // shortly after the first, and at once on pause
+    SessionJournalWriter m_journal;
+    QFile m_journalFile;
+    QTimer* m_journalTimer;
     
     // API Manager
     ApiManager* m_apiManager;
-    
-    // DSA Algorithms for question selection
-    void initializeQuestionQueue();
-    void selectNextQuestion();
-    void adjustDifficulty();
-    void updateStreaks(bool isCorrect);
+    int m_fetchRequest; // the current quiz's fetch, 0 when none is running
+    QuizPrefetcher* m_prefetcher;
+    
+    // Questions of a progressive start, pushed by the fetch as they are
+    // parsed; held until the next quiz replaces it
+    QSharedPointer<QuestionStream> m_stream;
+    bool m_progressiveStart;
+    bool m_providerFanOut;
+    QElapsedTimer m_firstQuestionTimer; // runs from startQuiz() until shown
+    qint64 m_timeToFirstQuestionMs;
+    
+    // Append-only results history, written behind by the persistence
+    // thread; readers flush it first
+    ResultsLog m_resultsLog;
+    PersistenceService* m_persistence;
+    
+    void beginSession(const QList<QuizQuestion>& questions);
+    void beginSession(const QuestionSetPtr& set);
+    void beginSession(const QSharedPointer<const QuestionPack>& pack);
+    void startSession(EngineBankPtr bank, const QByteArray& content);
+    QuestionContentPtr content(int index) const;
+    quint64 now() const;
+    qint64 remainingMillisecondsAt(quint64 time) const;
+    void scheduleQuestionDeadline(qint64 limitMs);
+    void cancelDeadlines();
+    void armDeadlineTimer();
+    void openJournal(const SessionStart& start);
+    // time is the one the engine was given for the same operation
+    void journal(quint64 time, SessionEventType type, qint32 value = -1, const QString& text = QString());
+    void journal(const SessionEvent& event);
+    void extendSession(const QList<QuestionContentPtr>& added);
+    void discardJournal();
+    static QString journalPath();
+    static QByteArray encodeContents(const QList<QuestionContentPtr>& contents);
+    static QList<QuestionContentPtr> decodeContents(const QByteArray& data);
+    static QByteArray encodePackReference(const QuestionPack& pack);
+    static QSharedPointer<const QuestionPack> decodePackReference(const QByteArray& data);
+    static QByteArray encodeSetReference(const QuestionSet& set);
+    static bool decodeSetReference(const QByteArray& data, QString& name);
+    bool resolveSetReference(const QString& name, const EngineBank& bank,
+                             QuestionSetPtr& set, QSharedPointer<const QuestionPack>& pack);
     QList<QuizQuestion> getQuestionsForDifficulty(Difficulty difficulty);
     
-    // Advanced DSA Algorithms
-    void buildQuestionPriorityQueue();
-    void updateQuestionWeights();
-    void adaptiveQuestionSelection();
-    void weightedRandomSelection();
-    void difficultyBasedSelection();
-    void performanceBasedSelection();
-    void timeBasedSelection();
-    
-    // Priority Queue for question selection
-    struct QuestionPriority {
-        int questionIndex;
-        double priority;
-        Difficulty difficulty;
-        int timeSpent;
-        bool answered;
-        
-        bool operator<(const QuestionPriority& other) const {
-            return priority < other.priority;
-        }
-    };
-    
-    std::priority_queue<QuestionPriority> m_questionQueue;
-    QHash<int, double> m_questionWeights;
-    QSet<int> m_answeredQuestions;
-    QMap<Difficulty, QList<int>> m_questionsByDifficulty;
-    QMap<Difficulty, double> m_difficultyWeights;
-    
-    // Performance tracking for adaptive selection
-    QMap<Difficulty, double> m_accuracyByDifficulty;
-    QMap<Difficulty, double> m_averageTimeByDifficulty;
-    QMap<Difficulty, int> m_attemptsByDifficulty;
-    
-    // Analytics tracking
-    QMap<Difficulty, int> m_difficultyStats;
-    QMap<Difficulty, int> m_correctByDifficulty;
-    QList<int> m_timePerQuestion;
-    
     // Helper methods
     void calculateStats();
     void saveQuizResults();
     void loadQuizResults();
-    void updatePerformanceMetrics(Difficulty difficulty, bool isCorrect, int timeSpent);
 };
 
 #endif // QUIZMANAGER_H 
\ No newline at end of file
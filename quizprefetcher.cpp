@@ -0,0 +1,197 @@
+#include "quizprefetcher.h"
+#include "apimanager.h"
+#include "questionstream.h"
+#include <QDebug>
+
+QuizPrefetcher::QuizPrefetcher(ApiManager* apiManager, int questionCount, QObject *parent)
+    : QObject(parent)
+    , m_apiManager(apiManager)
+    , m_questionCount(questionCount)
+    , m_readyBytes(0)
+    , m_request(0)
+    , m_wanted(false)
+    , m_retryTimer(new QTimer(this))
+{
+    m_retryTimer->setSingleShot(true);
+    connect(m_retryTimer, &QTimer::timeout, this, [this]() {
+        if (m_wanted) prefetch();
+    });
+    connect(m_apiManager, &ApiManager::requestFailed, this, &QuizPrefetcher::onRequestFailed);
+    connect(m_apiManager, &ApiManager::loadingStateChanged, this, &QuizPrefetcher::onLoadingStateChanged);
+}
+
+bool QuizPrefetcher::isPrefetchable(const QString& quizType)
+{
+    // The default quiz is fetched; built-in and custom sets are local
+    return quizType == "default";
+}
+
+void QuizPrefetcher::noteQuizStarted(const QString& quizType)
+{
+    m_starts[quizType]++;
+    m_lastStarted = quizType;
+}
+
+QString QuizPrefetcher::predictedQuizType() const
+{
+    // The type started most often, the latest one on a tie
+    QString predicted = m_lastStarted;
+    int most = m_starts.value(predicted);
+    for (auto it = m_starts.constBegin(); it != m_starts.constEnd(); ++it) {
+        if (it.value() > most) {
+            predicted = it.key();
+            most = it.value();
+        }
+    }
+    return predicted.isEmpty() ? QString("default") : predicted;
+}
+
+void QuizPrefetcher::prefetch()
+{
+    dropExpired();
+    QString quizType = predictedQuizType();
+    if (!isPrefetchable(quizType) || m_stream) return;
+    
+    // Memory budget: room for one more set
+    if (m_ready.size() >= MaxReadySets) return;
+    
+    // Rate budget: one request at a time, spaced out, and none while
+    // another fetch runs so the prefetch never joins a quiz's own transfer
+    if (m_apiManager->isLoading()) {
+        m_wanted = true;
+        return;
+    }
+    if (m_lastRequest.isValid() && m_lastRequest.elapsed() < MinIntervalMs) {
+        m_stats.throttled++;
+        m_wanted = true;
+        m_retryTimer->start(static_cast<int>(MinIntervalMs - m_lastRequest.elapsed()));
+        return;
+    }
+    
+    m_wanted = false;
+    m_retryTimer->stop();
+    m_lastRequest.start();
+    m_streamType = quizType;
+    m_received.clear();
+    m_stream = QSharedPointer<QuestionStream>(new QuestionStream(m_questionCount), &QObject::deleteLater);
+    connect(m_stream.data(), &QuestionStream::questionsAvailable,
+            this, &QuizPrefetcher::onStreamedQuestions, Qt::QueuedConnection);
+    m_request = m_apiManager->fetchQuestions(m_questionCount, m_stream);
+}
+
+QuestionSetPtr QuizPrefetcher::take(const QString& quizType)
+{
+    if (!isPrefetchable(quizType)) return QuestionSetPtr();
+    dropExpired();
+    for (int i = 0; i < m_ready.size(); ++i) {
+        if (m_ready[i].quizType != quizType) continue;
+        
+        ReadySet ready = m_ready.takeAt(i);
+        m_readyBytes -= ready.bytes;
+        m_stats.hits++;
+        return ready.set;
+    }
+    m_stats.misses++;
+    return QuestionSetPtr();
+}
+
+void QuizPrefetcher::cancel()
+{
+    if (!m_stream) return;
+    m_apiManager->cancelRequest(m_request);
+    m_stream->cancel();
+    disconnect(m_stream.data(), nullptr, this, nullptr);
+    m_stream.reset();
+    m_request = 0;
+    m_stats.failed++;
+}
+
+QuizPrefetcher::Stats QuizPrefetcher::stats() const
+{
+    Stats stats = m_stats;
+    stats.readySets = m_ready.size();
+    stats.readyBytes = m_readyBytes;
+    return stats;
+}
+
+void QuizPrefetcher::onStreamedQuestions()
+{
+    if (!m_stream) return;
+    m_received.append(m_stream->takeAvailable());
+    if (m_stream->isFinished()) {
+        finishPrefetch();
+    }
+}
+
+void QuizPrefetcher::onRequestFailed(int requestId, const QString& error)
+{
+    if (!m_stream || requestId != m_request) return;
+    
+    // What the stream was topped up with is the local fallback, which a
+    // quiz can have at any time without a prefetch
+    qDebug() << "Prefetch failed:" << error;
+    cancel();
+}
+
+void QuizPrefetcher::onLoadingStateChanged(bool loading)
+{
+    // A prefetch held back by a quiz's fetch goes out once that is done
+    if (!loading && m_wanted) {
+        prefetch();
+    }
+}
+
+qint64 QuizPrefetcher::approximateBytes(const QList<QuestionContentPtr>& contents)
+{
+    qint64 bytes = 0;
+    for (const QuestionContentPtr& content : contents) {
+        qint64 chars = content->question.size() + content->correctAnswer.size();
+        for (const QString& option : content->options) {
+            chars += option.size();
+        }
+        bytes += sizeof(QuestionContent) + chars * qint64(sizeof(QChar));
+    }
+    return bytes;
+}
+
+void QuizPrefetcher::dropExpired()
+{
+    // News goes stale; a set nobody took in time is not worth starting on
+    while (!m_ready.isEmpty() && m_ready.first().age.elapsed() > ReadyMaxAgeMs) {
+        m_readyBytes -= m_ready.takeFirst().bytes;
+        m_stats.discarded++;
+    }
+}
+
+void QuizPrefetcher::finishPrefetch()
+{
+    QList<QuestionContentPtr> contents = m_received;
+    QString quizType = m_streamType;
+    bool fellBack = m_stream->fellBack();
+    disconnect(m_stream.data(), nullptr, this, nullptr);
+    m_stream.reset();
+    m_request = 0;
+    m_received.clear();
+    
+    // Local questions are there for any quiz without a prefetch; holding
+    // them would only turn a later start's fetch into a stale hit
+    if (contents.isEmpty() || fellBack) {
+        m_stats.failed++;
+        return;
+    }
+    
+    ReadySet ready;
+    ready.quizType = quizType;
+    ready.set = QuestionBank::makeSet("prefetch", contents);
+    ready.bytes = approximateBytes(contents);
+    ready.age.start();
+    m_stats.fetched++;
+    
+    // Memory budget: the oldest sets give way to the newest
+    m_ready.append(ready);
+    m_readyBytes += ready.bytes;
+    while (m_ready.size() > 1 && (m_ready.size() > MaxReadySets || m_readyBytes > MaxReadyBytes)) {
+        m_readyBytes -= m_ready.takeFirst().bytes;
+        m_stats.discarded++;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef QUIZPREFETCHER_H
+#define QUIZPREFETCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include <QTimer>
+#include "questionbank.h"
+
+class ApiManager;
+class QuestionStream;
+
+// Keeps question sets for the next quiz ready in memory, so the quiz after
+// this one starts without a network round trip or a parse. Sets are
+// fetched in the background for the quiz type the user is likely to pick
+// next, while a quiz or the analytics screen is up, and are handed out
+// once each by take().
+//
+// Budgets: at most MaxReadySets sets and MaxReadyBytes of question text
+// are held, a set older than ReadyMaxAgeMs is dropped unused, and at most
+// one prefetch is in flight, never closer than MinIntervalMs to the last
+// and never while another fetch is running.
+class QuizPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MaxReadySets = 2;
+    static constexpr qint64 MaxReadyBytes = 512 * 1024;
+    static constexpr qint64 ReadyMaxAgeMs = 30 * 60 * 1000;
+    static constexpr qint64 MinIntervalMs = 60 * 1000;
+
+    struct Stats {
+        qint64 hits = 0;      // quizzes started on a prefetched set
+        qint64 misses = 0;    // quizzes of a prefetchable type that had none
+        qint64 fetched = 0;   // sets prefetched
+        qint64 failed = 0;    // prefetches that failed, fell back on local
+                              // questions or were cancelled
+        qint64 throttled = 0; // prefetches held back by the rate budget
+        qint64 discarded = 0; // sets dropped unused: too old or over budget
+        int readySets = 0;
+        qint64 readyBytes = 0;
+    };
+
+    QuizPrefetcher(ApiManager* apiManager, int questionCount, QObject *parent = nullptr);
+
+    // Whether a quiz type is fetched at all; the others start instantly
+    static bool isPrefetchable(const QString& quizType);
+
+    // Start history the next quiz type is predicted from
+    void noteQuizStarted(const QString& quizType);
+    QString predictedQuizType() const;
+
+    // Fetches a set for the predicted type if the budgets allow
+    void prefetch();
+    // A ready set for quizType, removed from the buffer; null on a miss
+    QuestionSetPtr take(const QString& quizType);
+    // Stops waiting on the prefetch in flight, if any
+    void cancel();
+
+    Stats stats() const;
+
+private slots:
+    void onStreamedQuestions();
+    void onRequestFailed(int requestId, const QString& error);
+    void onLoadingStateChanged(bool loading);
+
+private:
+    struct ReadySet {
+        QString quizType;
+        QuestionSetPtr set;
+        qint64 bytes;
+        QElapsedTimer age;
+    };
+
+    static qint64 approximateBytes(const QList<QuestionContentPtr>& contents);
+    void dropExpired();
+    void finishPrefetch();
+
+    ApiManager* m_apiManager;
+    int m_questionCount;
+    QHash<QString, int> m_starts; // quizzes started, by type
+    QString m_lastStarted;
+
+    QList<ReadySet> m_ready; // oldest first
+    qint64 m_readyBytes;
+
+    // The prefetch in flight
+    QSharedPointer<QuestionStream> m_stream;
+    QString m_streamType;
+    QList<QuestionContentPtr> m_received;
+    int m_request;
+    QElapsedTimer m_lastRequest;
+    bool m_wanted; // prefetch() was held back by the fetch running or the
+                   // rate budget, and runs again when that allows
+    QTimer* m_retryTimer; // single-shot, for the end of MinIntervalMs
+
+    Stats m_stats;
+};
+
+#endif // QUIZPREFETCHER_H
\ No newline at end of file
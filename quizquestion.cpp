@@ -1,78 +1,158 @@
 #include "quizquestion.h"
 #include <QJsonArray>
+#include <QCborStreamWriter>
+#include <QCborStreamReader>
+
+namespace {
+
+const QuestionContentPtr& emptyContent()
+{
+    // Shared by every default-constructed question
+    static const QuestionContentPtr empty = QSharedPointer<QuestionContent>::create();
+    return empty;
+}
+
+// Keys of a question map in the CBOR format. Attempt fields are only
+// written when set; unknown keys are skipped on read.
+enum CborKey : quint64 {
+    CborQuestion = 0,
+    CborOptions = 1,
+    CborCorrectIndex = 2,   // when the correct answer is one of the options
+    CborCorrectAnswer = 3,  // otherwise
+    CborDifficulty = 4,
+    CborType = 5,
+    CborAnswered = 6,
+    CborAnswerIndex = 7,
+    CborTimeSpentMs = 8
+};
+
+QString readCborText(QCborStreamReader& reader)
+{
+    QString text;
+    auto chunk = reader.readString();
+    while (chunk.status == QCborStreamReader::Ok) {
+        text += chunk.data;
+        chunk = reader.readString();
+    }
+    return text;
+}
+
+}
 
 QuizQuestion::QuizQuestion()
-    : m_difficulty(Difficulty::Easy)
-    , m_type(QuestionType::MultipleChoice)
-    , m_answered(false)
-    , m_timeSpent(0)
+    : m_content(emptyContent())
 {
 }
 
 QuizQuestion::QuizQuestion(const QString& question, const QStringList& options, 
                          const QString& correctAnswer, Difficulty difficulty, 
                          QuestionType type)
-    : m_question(question)
-    , m_options(options)
-    , m_correctAnswer(correctAnswer)
-    , m_difficulty(difficulty)
-    , m_type(type)
-    , m_answered(false)
-    , m_timeSpent(0)
+    : m_content(makeContent(question, options, correctAnswer, difficulty, type))
+{
+}
+
+QuizQuestion::QuizQuestion(const QuestionContentPtr& content, const QuestionAttempt& attempt)
+    : m_content(content ? content : emptyContent())
+    , m_attempt(attempt)
 {
 }
 
-QString QuizQuestion::getQuestion() const {
-    return m_question;
+const QString& QuizQuestion::getQuestion() const {
+    return m_content->question;
 }
 
-QStringList QuizQuestion::getOptions() const {
-    return m_options;
+const QStringList& QuizQuestion::getOptions() const {
+    return m_content->options;
 }
 
-QString QuizQuestion::getCorrectAnswer() const {
-    return m_correctAnswer;
+const QString& QuizQuestion::getCorrectAnswer() const {
+    return m_content->correctAnswer;
 }
 
 Difficulty QuizQuestion::getDifficulty() const {
-    return m_difficulty;
+    return m_content->difficulty;
 }
 
 QuestionType QuizQuestion::getType() const {
-    return m_type;
+    return m_content->type;
 }
 
 bool QuizQuestion::isAnswered() const {
-    return m_answered;
+    return m_attempt.answered;
 }
 
 QString QuizQuestion::getUserAnswer() const {
-    return m_userAnswer;
+    if (m_attempt.answerIndex < 0 || m_attempt.answerIndex >= m_content->options.size()) {
+        return QString();
+    }
+    return m_content->options[m_attempt.answerIndex];
 }
 
 bool QuizQuestion::isCorrect() const {
-    return m_answered && m_userAnswer == m_correctAnswer;
+    return m_attempt.answered && m_attempt.answerIndex >= 0 &&
+           m_attempt.answerIndex == m_content->correctIndex;
 }
 
 int QuizQuestion::getTimeSpent() const {
-    return m_timeSpent;
+    return static_cast<int>((m_attempt.timeSpentMs + 500) / 1000);
+}
+
+qint64 QuizQuestion::getTimeSpentMs() const {
+    return m_attempt.timeSpentMs;
 }
 
 void QuizQuestion::setUserAnswer(const QString& answer) {
-    m_userAnswer = answer;
-    m_answered = true;
+    // Answers are stored as an option index; anything that is not one of
+    // the options, or is past the 127 an attempt can hold, is recorded as
+    // answered with no option selected
+    qsizetype index = m_content->options.indexOf(answer);
+    m_attempt.answerIndex = static_cast<qint8>(index <= 127 ? index : -1);
+    m_attempt.answered = true;
 }
 
 void QuizQuestion::setTimeSpent(int seconds) {
-    m_timeSpent = seconds;
+    setTimeSpentMs(static_cast<qint64>(seconds) * 1000);
+}
+
+void QuizQuestion::setTimeSpentMs(qint64 milliseconds) {
+    m_attempt.timeSpentMs = static_cast<quint32>(qBound<qint64>(0, milliseconds, 0xffffffffLL));
 }
 
 void QuizQuestion::setAnswered(bool answered) {
-    m_answered = answered;
+    m_attempt.answered = answered;
+}
+
+const QuestionContentPtr& QuizQuestion::content() const {
+    return m_content;
+}
+
+const QuestionAttempt& QuizQuestion::attempt() const {
+    return m_attempt;
+}
+
+void QuizQuestion::setAttempt(const QuestionAttempt& attempt) {
+    m_attempt = attempt;
+}
+
+QuestionContentPtr QuizQuestion::makeContent(const QString& question, const QStringList& options,
+                                             const QString& correctAnswer, Difficulty difficulty,
+                                             QuestionType type) {
+    QSharedPointer<QuestionContent> content = QSharedPointer<QuestionContent>::create();
+    content->question = question;
+    content->options = options;
+    content->correctAnswer = correctAnswer;
+    content->difficulty = difficulty;
+    content->type = type;
+    content->correctIndex = options.indexOf(correctAnswer);
+    return content;
 }
 
 QString QuizQuestion::difficultyToString() const {
-    switch (m_difficulty) {
+    return difficultyToString(m_content->difficulty);
+}
+
+QString QuizQuestion::difficultyToString(Difficulty difficulty) {
+    switch (difficulty) {
         case Difficulty::Easy: return "Easy";
         case Difficulty::Medium: return "Medium";
         case Difficulty::Hard: return "Hard";
@@ -89,16 +169,17 @@ Difficulty QuizQuestion::stringToDifficulty(const QString& str) {
 
 QJsonObject QuizQuestion::toJson() const {
     QJsonObject obj;
-    obj["question"] = m_question;
-    obj["correctAnswer"] = m_correctAnswer;
+    obj["question"] = m_content->question;
+    obj["correctAnswer"] = m_content->correctAnswer;
     obj["difficulty"] = difficultyToString();
-    obj["type"] = (m_type == QuestionType::MultipleChoice) ? "multiple" : "boolean";
-    obj["answered"] = m_answered;
-    obj["userAnswer"] = m_userAnswer;
-    obj["timeSpent"] = m_timeSpent;
+    obj["type"] = (m_content->type == QuestionType::MultipleChoice) ? "multiple" : "boolean";
+    obj["answered"] = m_attempt.answered;
+    obj["userAnswer"] = getUserAnswer();
+    obj["timeSpent"] = getTimeSpent();
+    obj["timeSpentMs"] = getTimeSpentMs();
     
     QJsonArray optionsArray;
-    for (const QString& option : m_options) {
+    for (const QString& option : m_content->options) {
         optionsArray.append(option);
     }
     obj["options"] = optionsArray;
@@ -120,20 +201,136 @@ QuizQuestion QuizQuestion::fromJson(const QJsonObject& json) {
     QuizQuestion q(question, options, correctAnswer, difficulty);
     q.setUserAnswer(json["userAnswer"].toString());
     q.setAnswered(json["answered"].toBool());
-    q.setTimeSpent(json["timeSpent"].toInt());
+    if (json.contains("timeSpentMs")) {
+        q.setTimeSpentMs(json["timeSpentMs"].toInteger());
+    } else {
+        q.setTimeSpent(json["timeSpent"].toInt());
+    }
     
     return q;
 }
 
+void QuizQuestion::toCbor(QCborStreamWriter& writer) const {
+    const QuestionContent& content = *m_content;
+    int fields = 5 + (m_attempt.answered ? 1 : 0) + (m_attempt.answerIndex >= 0 ? 1 : 0)
+               + (m_attempt.timeSpentMs > 0 ? 1 : 0);
+    
+    writer.startMap(fields);
+    writer.append(quint64(CborQuestion));
+    writer.append(content.question);
+    writer.append(quint64(CborOptions));
+    writer.startArray(content.options.size());
+    for (const QString& option : content.options) {
+        writer.append(option);
+    }
+    writer.endArray();
+    if (content.correctIndex >= 0) {
+        writer.append(quint64(CborCorrectIndex));
+        writer.append(quint64(content.correctIndex));
+    } else {
+        writer.append(quint64(CborCorrectAnswer));
+        writer.append(content.correctAnswer);
+    }
+    writer.append(quint64(CborDifficulty));
+    writer.append(quint64(static_cast<int>(content.difficulty)));
+    writer.append(quint64(CborType));
+    writer.append(quint64(static_cast<int>(content.type)));
+    
+    if (m_attempt.answered) {
+        writer.append(quint64(CborAnswered));
+        writer.append(true);
+    }
+    if (m_attempt.answerIndex >= 0) {
+        writer.append(quint64(CborAnswerIndex));
+        writer.append(quint64(m_attempt.answerIndex));
+    }
+    if (m_attempt.timeSpentMs > 0) {
+        writer.append(quint64(CborTimeSpentMs));
+        writer.append(quint64(m_attempt.timeSpentMs));
+    }
+    writer.endMap();
+}
+
+bool QuizQuestion::fromCbor(QCborStreamReader& reader, QuizQuestion& question) {
+    if (!reader.isMap() || !reader.enterContainer()) return false;
+    
+    QString text;
+    QStringList options;
+    QString correctAnswer;
+    qint64 correctIndex = -1;
+    Difficulty difficulty = Difficulty::Easy;
+    QuestionType type = QuestionType::MultipleChoice;
+    QuestionAttempt attempt;
+    
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        if (!reader.isUnsignedInteger()) {
+            // Not one of ours: skip key and value
+            reader.next();
+            reader.next();
+            continue;
+        }
+        quint64 key = reader.toUnsignedInteger();
+        reader.next();
+        
+        if (key == CborQuestion && reader.isString()) {
+            text = readCborText(reader);
+        } else if (key == CborOptions && reader.isArray()) {
+            if (reader.isLengthKnown()) {
+                options.reserve(static_cast<qsizetype>(reader.length()));
+            }
+            reader.enterContainer();
+            while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+                if (reader.isString()) {
+                    options.append(readCborText(reader));
+                } else {
+                    reader.next();
+                }
+            }
+            reader.leaveContainer();
+        } else if (key == CborCorrectIndex && reader.isInteger()) {
+            correctIndex = reader.toInteger();
+            reader.next();
+        } else if (key == CborCorrectAnswer && reader.isString()) {
+            correctAnswer = readCborText(reader);
+        } else if (key == CborDifficulty && reader.isUnsignedInteger()) {
+            difficulty = static_cast<Difficulty>(qMin<quint64>(reader.toUnsignedInteger(), 2));
+            reader.next();
+        } else if (key == CborType && reader.isUnsignedInteger()) {
+            type = reader.toUnsignedInteger() == 1 ? QuestionType::TrueFalse : QuestionType::MultipleChoice;
+            reader.next();
+        } else if (key == CborAnswered && reader.isBool()) {
+            attempt.answered = reader.toBool();
+            reader.next();
+        } else if (key == CborAnswerIndex && reader.isInteger()) {
+            attempt.answerIndex = static_cast<qint8>(qBound<qint64>(-1, reader.toInteger(), 127));
+            reader.next();
+        } else if (key == CborTimeSpentMs && reader.isUnsignedInteger()) {
+            attempt.timeSpentMs = static_cast<quint32>(qMin<quint64>(reader.toUnsignedInteger(), 0xffffffffULL));
+            reader.next();
+        } else {
+            reader.next();
+        }
+    }
+    if (reader.lastError() != QCborError::NoError || !reader.leaveContainer()) return false;
+    
+    if (correctIndex >= 0 && correctIndex < options.size()) {
+        correctAnswer = options[correctIndex];
+    }
+    question = QuizQuestion(text, options, correctAnswer, difficulty, type);
+    question.setAttempt(attempt);
+    return true;
+}
+
 bool QuizQuestion::operator==(const QuizQuestion& other) const {
-    return m_question == other.m_question && 
-           m_correctAnswer == other.m_correctAnswer &&
-           m_difficulty == other.m_difficulty;
+    if (m_content == other.m_content) return true;
+    return m_content->question == other.m_content->question && 
+           m_content->correctAnswer == other.m_content->correctAnswer &&
+           m_content->difficulty == other.m_content->difficulty;
 }
 
 bool QuizQuestion::operator<(const QuizQuestion& other) const {
-    if (m_difficulty != other.m_difficulty) {
-        return static_cast<int>(m_difficulty) < static_cast<int>(other.m_difficulty);
+    if (m_content->difficulty != other.m_content->difficulty) {
+        return static_cast<int>(m_content->difficulty) < static_cast<int>(other.m_content->difficulty);
     }
-    return m_question < other.m_question;
-} 
\ No newline at end of file
+    return m_content->question < other.m_content->question;
+}
\ No newline at end of file
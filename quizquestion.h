@@ -4,60 +4,79 @@
 #include <QString>
 #include <QStringList>
 #include <QJsonObject>
+#include <QSharedPointer>
+#include "quiztypes.h"
 
-enum class Difficulty {
-    Easy,
-    Medium,
-    Hard
-};
+class QCborStreamWriter;
+class QCborStreamReader;
 
-enum class QuestionType {
-    MultipleChoice,
-    TrueFalse
+// Immutable question content. Built once per bank and shared (refcounted)
+// by every session that uses the question.
+struct QuestionContent {
+    QString question;
+    QStringList options;
+    QString correctAnswer;
+    Difficulty difficulty = Difficulty::Easy;
+    QuestionType type = QuestionType::MultipleChoice;
+    int correctIndex = -1; // index of correctAnswer in options, -1 if absent
 };
 
+using QuestionContentPtr = QSharedPointer<const QuestionContent>;
+
 class QuizQuestion {
 public:
     QuizQuestion();
     QuizQuestion(const QString& question, const QStringList& options, 
                  const QString& correctAnswer, Difficulty difficulty, 
                  QuestionType type = QuestionType::MultipleChoice);
+    explicit QuizQuestion(const QuestionContentPtr& content,
+                          const QuestionAttempt& attempt = QuestionAttempt());
     
     // Getters
-    QString getQuestion() const;
-    QStringList getOptions() const;
-    QString getCorrectAnswer() const;
+    const QString& getQuestion() const;
+    const QStringList& getOptions() const;
+    const QString& getCorrectAnswer() const;
     Difficulty getDifficulty() const;
     QuestionType getType() const;
     bool isAnswered() const;
     QString getUserAnswer() const;
     bool isCorrect() const;
-    int getTimeSpent() const;
+    int getTimeSpent() const; // in seconds
+    qint64 getTimeSpentMs() const;
     
     // Setters
     void setUserAnswer(const QString& answer);
     void setTimeSpent(int seconds);
+    void setTimeSpentMs(qint64 milliseconds);
     void setAnswered(bool answered);
     
+    // Shared content / attempt split
+    const QuestionContentPtr& content() const;
+    const QuestionAttempt& attempt() const;
+    void setAttempt(const QuestionAttempt& attempt);
+    static QuestionContentPtr makeContent(const QString& question, const QStringList& options,
+                                          const QString& correctAnswer, Difficulty difficulty,
+                                          QuestionType type = QuestionType::MultipleChoice);
+    
     // Utility
     QString difficultyToString() const;
+    static QString difficultyToString(Difficulty difficulty);
     static Difficulty stringToDifficulty(const QString& str);
     QJsonObject toJson() const;
     static QuizQuestion fromJson(const QJsonObject& json);
     
+    // Compact binary form: a CBOR map with small integer keys, streamed.
+    // fromCbor() returns false on malformed input.
+    void toCbor(QCborStreamWriter& writer) const;
+    static bool fromCbor(QCborStreamReader& reader, QuizQuestion& question);
+    
     // DSA algorithms for question analysis
     bool operator==(const QuizQuestion& other) const;
     bool operator<(const QuizQuestion& other) const;
 
 private:
-    QString m_question;
-    QStringList m_options;
-    QString m_correctAnswer;
-    Difficulty m_difficulty;
-    QuestionType m_type;
-    QString m_userAnswer;
-    bool m_answered;
-    int m_timeSpent; // in seconds
+    QuestionContentPtr m_content;
+    QuestionAttempt m_attempt;
 };
 
-#endif // QUIZQUESTION_H 
\ No newline at end of file
+#endif // QUIZQUESTION_H
\ No newline at end of file
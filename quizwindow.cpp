@@ -323,7 +323,9 @@ void QuizWindow::setupConnections()
     connect(m_quizManager, &QuizManager::difficultyChanged, this, &QuizWindow::onDifficultyChanged);
     connect(m_quizManager, &QuizManager::progressUpdated, this, &QuizWindow::onProgressUpdated);
     connect(m_quizManager, &QuizManager::streakUpdated, this, &QuizWindow::onStreakUpdated);
+    connect(m_quizManager, &QuizManager::quizStarted, this, &QuizWindow::onQuizStarted);
     connect(m_quizManager, &QuizManager::quizFinished, this, &QuizWindow::onQuizFinished);
+    connect(m_quizManager, &QuizManager::questionsAdded, this, &QuizWindow::onQuestionsAdded);
     
     // Navigation connections
     connect(m_nextButton, &QPushButton::clicked, this, &QuizWindow::nextQuestion);
@@ -337,8 +339,9 @@ void QuizWindow::setupConnections()
     connect(m_quizManager, &QuizManager::quizPaused, this, &QuizWindow::onQuizPaused);
     connect(m_quizManager, &QuizManager::quizResumed, this, &QuizWindow::onQuizResumed);
     
-    // Timer connections
-    connect(m_timerWidget, &TimerWidget::timeUp, this, &QuizWindow::onTimeUp);
+    // Timer connections: the widget polls the quiz deadline when it refreshes;
+    // running out is handled by the manager, which then finishes the quiz
+    m_timerWidget->setTimeSource([this]() { return m_quizManager->getRemainingMilliseconds(); });
     
     // Question grid connections
     connect(m_questionGrid, &QListWidget::itemClicked, [this](QListWidgetItem* item) {
@@ -443,13 +446,22 @@ void QuizWindow::onAnswerSubmitted(int index, bool correct)
     }
     
     // Update navigation buttons
-    m_nextButton->setEnabled(index < m_quizManager->getTotalQuestions() - 1);
+    m_nextButton->setEnabled(m_quizManager->hasNextQuestion());
     m_previousButton->setEnabled(index > 0);
 }
 
+void QuizWindow::onQuizStarted()
+{
+    m_timerWidget->stopTimer();
+    m_timerWidget->setTime(m_quizManager->getQuizDuration());
+    m_timerWidget->startTimer();
+}
+
 void QuizWindow::onTimeUpdated(int remainingSeconds)
 {
-    m_timerWidget->setTime(remainingSeconds);
+    // Sent when the quiz starts or runs out, not every second; the widget
+    // is started and stopped by quizStarted and quizFinished
+    m_timerWidget->refresh();
 }
 
 void QuizWindow::onDifficultyChanged(Difficulty newDifficulty)
@@ -476,6 +488,25 @@ void QuizWindow::onQuizFinished()
 {
     // Quiz finished - let MainWindow handle the popup and navigation
     // No popup here to avoid duplicates
+    m_timerWidget->stopTimer();
+    m_timerWidget->refresh();
+}
+
+void QuizWindow::onQuestionsAdded(int total)
+{
+    // Questions streamed into the running quiz get grid cells of their
+    // own; the cells already there are left as they are
+    for (int i = m_questionGrid->count(); i < total; ++i) {
+        QListWidgetItem* item = new QListWidgetItem();
+        item->setText(QString::number(i + 1));
+        item->setData(Qt::UserRole, i);
+        item->setBackground(QColor(getStatusColor(false, false)));
+        m_questionGrid->addItem(item);
+    }
+    
+    updateProgress();
+    updateSummary();
+    m_nextButton->setEnabled(m_quizManager->hasNextQuestion());
 }
 
 void QuizWindow::nextQuestion()
@@ -539,12 +570,6 @@ void QuizWindow::goToQuestion(int index)
     m_quizManager->goToQuestion(index);
 }
 
-void QuizWindow::onTimeUp()
-{
-    QMessageBox::warning(this, "Time's Up!", "Time has expired. Quiz will be finished automatically.");
-    finishQuiz();
-}
-
 void QuizWindow::updateQuestionDisplay()
 {
     QuizQuestion currentQuestion = m_quizManager->getCurrentQuestion();
@@ -592,7 +617,7 @@ void QuizWindow::updateQuestionDisplay()
     updateOptionButtonStyles();
     
     // Update navigation buttons
-    m_nextButton->setEnabled(m_currentQuestionIndex < m_quizManager->getTotalQuestions() - 1);
+    m_nextButton->setEnabled(m_quizManager->hasNextQuestion());
     m_previousButton->setEnabled(m_currentQuestionIndex > 0);
 }
 
@@ -600,22 +625,15 @@ void QuizWindow::updateQuestionGrid()
 {
     m_questionGrid->clear();
     
+    // Engine state only; no question text is decoded for the grid
     for (int i = 0; i < m_quizManager->getTotalQuestions(); ++i) {
         QListWidgetItem* item = new QListWidgetItem();
         item->setText(QString::number(i + 1));
         item->setData(Qt::UserRole, i);
         
         // Set icon based on status
-        bool answered = false;
-        bool correct = false;
-        
-        if (i < m_quizManager->getAllQuestions().size()) {
-            const QuizQuestion& question = m_quizManager->getAllQuestions()[i];
-            answered = question.isAnswered();
-            correct = question.isCorrect();
-        }
-        
-        QString statusColor = getStatusColor(answered, correct);
+        QuizManager::QuestionStatus status = m_quizManager->getQuestionStatus(i);
+        QString statusColor = getStatusColor(status.answered, status.correct);
         item->setBackground(QColor(statusColor));
         
         if (i == m_currentQuestionIndex) {
@@ -41,7 +41,9 @@ public slots:
     void onStreakUpdated(int consecutiveCorrect, int consecutiveWrong);
     void onQuizPaused();
     void onQuizResumed();
+    void onQuizStarted();
     void onQuizFinished();
+    void onQuestionsAdded(int total);
     
     // Navigation slots
     void nextQuestion();
@@ -53,7 +55,6 @@ public slots:
     void goToQuestion(int index);
     
     // Timer slots
-    void onTimeUp();
     void onFlickerTimer();
 
 private:
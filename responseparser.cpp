@@ -0,0 +1,122 @@
+#include "responseparser.h"
+#include <QElapsedTimer>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QThreadPool>
+
+ResponseParser::ResponseParser(QThreadPool* pool, const QString& arrayKey, Converter converter,
+                               QuestionHandler onQuestion)
+    : m_pool(pool)
+    , m_converter(std::move(converter))
+    , m_onQuestion(std::move(onQuestion))
+    , m_context(nullptr)
+    , m_closed(false)
+    , m_running(false)
+    , m_stream(arrayKey, [this](const QJsonObject& element) {
+          QuizQuestion question;
+          if (!m_converter(element, m_rng, question)) return true;
+          m_questions.append(question);
+          return !m_onQuestion || m_onQuestion(question, m_questions.size());
+      })
+    , m_rng(QRandomGenerator::global()->generate())
+    , m_complete(false)
+    , m_parseNs(0)
+    , m_callerNs(0)
+{
+}
+
+void ResponseParser::feed(const QByteArray& bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_closed || bytes.isEmpty()) return;
+    m_chunks.append(bytes);
+    schedule();
+}
+
+void ResponseParser::finish(QObject* context, Done done)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_closed) return;
+    m_closed = true;
+    m_context = context;
+    m_done = std::move(done);
+    schedule();
+}
+
+const QList<QuizQuestion>& ResponseParser::questions() const
+{
+    return m_questions;
+}
+
+bool ResponseParser::isComplete() const
+{
+    return m_complete;
+}
+
+QJsonObject ResponseParser::fields() const
+{
+    return m_stream.fields();
+}
+
+QString ResponseParser::errorString() const
+{
+    return m_stream.errorString();
+}
+
+double ResponseParser::parseMs() const
+{
+    return m_parseNs / 1e6;
+}
+
+void ResponseParser::addCallerTime(qint64 nsecs)
+{
+    m_callerNs += nsecs;
+}
+
+double ResponseParser::callerMs() const
+{
+    return m_callerNs / 1e6;
+}
+
+void ResponseParser::schedule()
+{
+    // Called with the mutex held. One task at a time keeps the chunks in
+    // order; the running one picks up whatever is queued meanwhile.
+    if (m_running) return;
+    m_running = true;
+    QSharedPointer<ResponseParser> self = sharedFromThis();
+    m_pool->start([self]() { self->drain(); });
+}
+
+void ResponseParser::drain()
+{
+    for (;;) {
+        QByteArray chunk;
+        Done done;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_chunks.isEmpty()) {
+                chunk = m_chunks.takeFirst();
+            } else if (m_done) {
+                done = std::move(m_done);
+                m_done = nullptr;
+            } else {
+                m_running = false;
+                return;
+            }
+        }
+        
+        QElapsedTimer timer;
+        timer.start();
+        if (done) {
+            m_complete = m_stream.isStopped() || m_stream.finish();
+            m_parseNs += timer.nsecsElapsed();
+            QMetaObject::invokeMethod(m_context, std::move(done), Qt::QueuedConnection);
+            continue;
+        }
+        
+        // Chunks past a stop are dropped unparsed
+        m_stream.feed(chunk);
+        m_parseNs += timer.nsecsElapsed();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef RESPONSEPARSER_H
+#define RESPONSEPARSER_H
+
+#include <QByteArray>
+#include <QEnableSharedFromThis>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <functional>
+#include <random>
+#include "jsonarraystream.h"
+#include "quizquestion.h"
+
+class QObject;
+class QThreadPool;
+
+// Parses one provider response on a thread pool while its body is still
+// arriving. The caller feeds chunks and returns at once; decoding the JSON
+// and building the questions happen on the pool, so the caller's thread
+// only copies bytes.
+//
+// Chunks of one response are parsed in order, by one pool task at a time;
+// different responses parse in parallel. A task drains every chunk queued
+// so far and ends, so no pool thread ever waits on the network.
+class ResponseParser : public QEnableSharedFromThis<ResponseParser>
+{
+public:
+    // Builds a question from one array element. Runs on the pool; rng is
+    // this response's own generator.
+    using Converter = std::function<bool(const QJsonObject& element, std::mt19937& rng, QuizQuestion& question)>;
+    // Each question as it is built, on the pool, with the number built so
+    // far; returning false stops parsing
+    using QuestionHandler = std::function<bool(const QuizQuestion& question, int received)>;
+    // Runs once, after the last chunk has been parsed
+    using Done = std::function<void()>;
+
+    ResponseParser(QThreadPool* pool, const QString& arrayKey, Converter converter,
+                   QuestionHandler onQuestion = QuestionHandler());
+
+    // Both return at once and may be called from any thread
+    void feed(const QByteArray& bytes);
+    // No more input; later feeds are ignored. done is queued to context's
+    // thread, which must outlive the parse.
+    void finish(QObject* context, Done done);
+
+    // Valid once done has run
+    const QList<QuizQuestion>& questions() const;
+    bool isComplete() const; // well formed to the end, or stopped early
+    QJsonObject fields() const;
+    QString errorString() const;
+    double parseMs() const;  // pool time spent parsing
+
+    // Time the caller's thread spent on this response, which it measures
+    // and reports itself
+    void addCallerTime(qint64 nsecs);
+    double callerMs() const;
+
+private:
+    void schedule();
+    void drain();
+
+    QThreadPool* m_pool;
+    Converter m_converter;
+    QuestionHandler m_onQuestion;
+
+    // Shared with the feeding thread
+    mutable QMutex m_mutex;
+    QList<QByteArray> m_chunks;
+    QObject* m_context;
+    Done m_done;
+    bool m_closed;
+    bool m_running; // a pool task is draining
+
+    // Owned by whichever pool task is draining
+    JsonArrayStream m_stream;
+    std::mt19937 m_rng;
+    QList<QuizQuestion> m_questions;
+    bool m_complete;
+    qint64 m_parseNs;
+
+    qint64 m_callerNs; // caller's thread only
+};
+
+#endif // RESPONSEPARSER_H
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "resultslog.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QtEndian>
+#include <QDebug>
+
+namespace {
+constexpr qint64 IndexEntrySize = 16;
+}
+
+ResultsLog::ResultsLog(const QString& directory)
+    : m_logPath(QDir(directory).filePath("quiz_results.log"))
+    , m_indexPath(QDir(directory).filePath("quiz_results.idx"))
+{
+    QDir().mkpath(directory);
+    repair();
+}
+
+bool ResultsLog::append(QJsonObject record)
+{
+    if (!record.contains("timestamp")) {
+        record["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    }
+    QByteArray line = QJsonDocument(record).toJson(QJsonDocument::Compact);
+    line.append('\n');
+    
+    QFile log(m_logPath);
+    QFile index(m_indexPath);
+    if (!log.open(QIODevice::ReadWrite) || !index.open(QIODevice::ReadWrite)) {
+        qDebug() << "Cannot open results log" << m_logPath;
+        return false;
+    }
+    
+    // Index times stay sorted even if the wall clock steps back
+    IndexEntry entry;
+    entry.time = recordTime(line);
+    entry.offset = log.size();
+    qint64 entries = index.size() / IndexEntrySize;
+    IndexEntry previous;
+    if (entries > 0 && readEntry(index, entries - 1, previous)) {
+        entry.time = qMax(entry.time, previous.time);
+    }
+    
+    // Record first, then its entry; an append cut short between the two is
+    // repaired on the next open
+    log.seek(entry.offset);
+    if (log.write(line) != line.size() || !log.flush()) {
+        return false;
+    }
+    index.seek(entries * IndexEntrySize);
+    return index.write(encodeEntry(entry)) == IndexEntrySize;
+}
+
+qint64 ResultsLog::count() const
+{
+    return QFileInfo(m_indexPath).size() / IndexEntrySize;
+}
+
+QList<QJsonObject> ResultsLog::last(int count) const
+{
+    qint64 total = this->count();
+    return readRecords(qMax<qint64>(0, total - count), total);
+}
+
+QList<QJsonObject> ResultsLog::between(const QDateTime& from, const QDateTime& to) const
+{
+    QFile index(m_indexPath);
+    if (!index.open(QIODevice::ReadOnly)) return QList<QJsonObject>();
+    qint64 total = index.size() / IndexEntrySize;
+    
+    // First entry at or after time, by binary search over the index
+    auto lowerBound = [&index, total](qint64 time) {
+        qint64 low = 0;
+        qint64 high = total;
+        IndexEntry entry;
+        while (low < high) {
+            qint64 middle = low + (high - low) / 2;
+            if (readEntry(index, middle, entry) && entry.time < time) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    };
+    
+    qint64 first = lowerBound(from.toMSecsSinceEpoch());
+    qint64 end = lowerBound(to.toMSecsSinceEpoch() + 1);
+    index.close();
+    return readRecords(first, end);
+}
+
+QString ResultsLog::logPath() const
+{
+    return m_logPath;
+}
+
+QString ResultsLog::indexPath() const
+{
+    return m_indexPath;
+}
+
+void ResultsLog::repair() const
+{
+    QFile log(m_logPath);
+    QFile index(m_indexPath);
+    if (!log.open(QIODevice::ReadWrite) || !index.open(QIODevice::ReadWrite)) return;
+    
+    // Drop a partial entry and any that point past the end of the log
+    qint64 entries = index.size() / IndexEntrySize;
+    IndexEntry entry;
+    while (entries > 0 && (!readEntry(index, entries - 1, entry) || entry.offset >= log.size())) {
+        --entries;
+    }
+    index.resize(entries * IndexEntrySize);
+    
+    // Resume after the last indexed record; usually that is the end
+    qint64 position = 0;
+    qint64 lastTime = 0;
+    if (entries > 0) {
+        log.seek(entry.offset);
+        log.readLine();
+        position = log.pos();
+        lastTime = entry.time;
+    }
+    if (position >= log.size()) return;
+    
+    index.seek(index.size());
+    log.seek(position);
+    while (!log.atEnd()) {
+        qint64 offset = log.pos();
+        QByteArray line = log.readLine();
+        if (!line.endsWith('\n')) {
+            // Torn last record
+            log.resize(offset);
+            break;
+        }
+        
+        IndexEntry missing;
+        missing.time = qMax(lastTime, recordTime(line));
+        missing.offset = offset;
+        index.write(encodeEntry(missing));
+        lastTime = missing.time;
+    }
+}
+
+bool ResultsLog::readEntry(QFile& index, qint64 position, IndexEntry& entry)
+{
+    if (!index.seek(position * IndexEntrySize)) return false;
+    QByteArray bytes = index.read(IndexEntrySize);
+    if (bytes.size() != IndexEntrySize) return false;
+    
+    entry.time = qFromLittleEndian<qint64>(bytes.constData());
+    entry.offset = qFromLittleEndian<qint64>(bytes.constData() + 8);
+    return true;
+}
+
+QByteArray ResultsLog::encodeEntry(const IndexEntry& entry)
+{
+    QByteArray bytes(IndexEntrySize, Qt::Uninitialized);
+    qToLittleEndian<qint64>(entry.time, bytes.data());
+    qToLittleEndian<qint64>(entry.offset, bytes.data() + 8);
+    return bytes;
+}
+
+qint64 ResultsLog::recordTime(const QByteArray& line)
+{
+    QString timestamp = QJsonDocument::fromJson(line).object().value("timestamp").toString();
+    QDateTime time = QDateTime::fromString(timestamp, Qt::ISODateWithMs);
+    return time.isValid() ? time.toMSecsSinceEpoch() : 0;
+}
+
+QList<QJsonObject> ResultsLog::readRecords(qint64 first, qint64 end) const
+{
+    QList<QJsonObject> records;
+    if (first >= end) return records;
+    
+    QFile index(m_indexPath);
+    QFile log(m_logPath);
+    if (!index.open(QIODevice::ReadOnly) || !log.open(QIODevice::ReadOnly)) return records;
+    
+    // The entries of a range are contiguous: one read for all of them, then
+    // one seek and line per record
+    index.seek(first * IndexEntrySize);
+    QByteArray entries = index.read((end - first) * IndexEntrySize);
+    records.reserve(entries.size() / IndexEntrySize);
+    for (qint64 i = 0; i + IndexEntrySize <= entries.size(); i += IndexEntrySize) {
+        qint64 offset = qFromLittleEndian<qint64>(entries.constData() + i + 8);
+        if (!log.seek(offset)) break;
+        records.append(QJsonDocument::fromJson(log.readLine()).object());
+    }
+    return records;
+}
\ No newline at end of file
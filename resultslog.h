@@ -0,0 +1,50 @@
+#ifndef RESULTSLOG_H
+#define RESULTSLOG_H
+
+#include <QString>
+#include <QList>
+#include <QJsonObject>
+#include <QDateTime>
+
+class QFile;
+
+// Append-only history of quiz results: one compact JSON record per line in
+// quiz_results.log, plus quiz_results.idx holding a fixed 16-byte entry
+// (record time in ms since the epoch, byte offset) per record. Appending
+// writes one record and one entry; the last N records or a time range are
+// found through the index and read by offset, without parsing the rest of
+// the log. Index times never go backwards, so ranges are binary searched.
+class ResultsLog
+{
+public:
+    explicit ResultsLog(const QString& directory);
+
+    // Appends record, stamped with its "timestamp" (set to now if missing)
+    bool append(QJsonObject record);
+
+    qint64 count() const;
+    QList<QJsonObject> last(int count) const;             // oldest first
+    QList<QJsonObject> between(const QDateTime& from, const QDateTime& to) const;
+
+    QString logPath() const;
+    QString indexPath() const;
+
+private:
+    struct IndexEntry {
+        qint64 time = 0;
+        qint64 offset = 0;
+    };
+
+    // Brings the index level with the log after an interrupted append:
+    // indexes complete records it is missing and cuts a torn last line
+    void repair() const;
+    static bool readEntry(QFile& index, qint64 position, IndexEntry& entry);
+    static QByteArray encodeEntry(const IndexEntry& entry);
+    static qint64 recordTime(const QByteArray& line);
+    QList<QJsonObject> readRecords(qint64 first, qint64 end) const;
+
+    QString m_logPath;
+    QString m_indexPath;
+};
+
+#endif // RESULTSLOG_H
\ No newline at end of file
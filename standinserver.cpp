@@ -0,0 +1,251 @@
+#include "standinserver.h"
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QUrlQuery>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTimer>
+#include <QPointer>
+
+StandInServer::StandInServer(const Config& config, QObject *parent)
+    : QObject(parent)
+    , m_config(config)
+    , m_rng(config.seed)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &StandInServer::onNewConnection);
+}
+
+bool StandInServer::listen(quint16 port)
+{
+    return m_server.listen(QHostAddress::LocalHost, port);
+}
+
+quint16 StandInServer::port() const
+{
+    return m_server.serverPort();
+}
+
+QUrl StandInServer::baseUrl() const
+{
+    return QUrl(QString("http://127.0.0.1:%1").arg(port()));
+}
+
+QUrl StandInServer::providerUrl(const QString& name) const
+{
+    QUrl url = baseUrl();
+    if (name == "newsapi") {
+        url.setPath("/v2/top-headlines");
+    } else if (name == "opentdb") {
+        url.setPath("/api.php");
+    } else if (name == "geeksforgeeks") {
+        url.setPath("/problems/get-problems");
+        url.setQuery("category=all&difficulty=all&type=all");
+    } else {
+        return QUrl();
+    }
+    return url;
+}
+
+void StandInServer::setConfig(const Config& config)
+{
+    m_config = config;
+    m_rng.seed(config.seed);
+    m_bodies.clear();
+}
+
+StandInServer::Config StandInServer::config() const
+{
+    return m_config;
+}
+
+StandInServer::Stats StandInServer::stats() const
+{
+    return m_stats;
+}
+
+void StandInServer::resetStats()
+{
+    m_stats = Stats();
+}
+
+void StandInServer::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            QByteArray& head = m_heads[socket];
+            head.append(socket->readAll());
+            if (!head.contains("\r\n\r\n")) return;
+            QByteArray request = head;
+            m_heads.remove(socket);
+            disconnect(socket, &QTcpSocket::readyRead, this, nullptr);
+            handleRequest(socket, request);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_heads.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void StandInServer::handleRequest(QTcpSocket* socket, const QByteArray& head)
+{
+    m_stats.requests++;
+    
+    // Request line and the one header that matters
+    QList<QByteArray> lines = head.left(head.indexOf("\r\n\r\n")).split('\n');
+    QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+    QUrl target(QString::fromLatin1(requestLine.value(1)));
+    QByteArray ifNoneMatch;
+    for (int i = 1; i < lines.size(); ++i) {
+        int colon = lines[i].indexOf(':');
+        if (colon > 0 && lines[i].left(colon).trimmed().toLower() == "if-none-match") {
+            ifNoneMatch = lines[i].mid(colon + 1).trimmed();
+        }
+    }
+    
+    // Decided now, in arrival order, so a seed always fails the same requests
+    bool fail = m_config.errorRate > 0.0
+        && std::bernoulli_distribution(qBound(0.0, m_config.errorRate, 1.0))(m_rng);
+    
+    QUrlQuery query(target);
+    QString path = target.path();
+    QString countKey = path == "/v2/top-headlines" ? "pageSize" : path == "/api.php" ? "amount" : QString();
+    int count = m_config.items;
+    if (!countKey.isEmpty() && query.hasQueryItem(countKey)) {
+        count = qBound(0, query.queryItemValue(countKey).toInt(), m_config.items);
+    }
+    QByteArray body = responseBody(path, count);
+    
+    QPointer<QTcpSocket> client(socket);
+    QTimer::singleShot(m_config.latencyMs, this, [this, client, fail, body, ifNoneMatch]() {
+        if (!client) return;
+        if (body.isNull()) {
+            m_stats.notFound++;
+            respond(client, 404, QByteArray(), QByteArray());
+            return;
+        }
+        if (fail) {
+            m_stats.errors++;
+            respond(client, 503, QByteArray(), QByteArray());
+            return;
+        }
+        QByteArray etag = '"' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex().left(16) + '"';
+        if (ifNoneMatch == etag) {
+            m_stats.notModified++;
+            respond(client, 304, etag, QByteArray());
+            return;
+        }
+        m_stats.served++;
+        m_stats.bodyBytes += body.size();
+        respond(client, 200, etag, body);
+    });
+}
+
+void StandInServer::respond(QTcpSocket* socket, int status, const QByteArray& etag, const QByteArray& body)
+{
+    const char* reason = status == 200 ? "OK"
+        : status == 304 ? "Not Modified"
+        : status == 404 ? "Not Found" : "Service Unavailable";
+    QByteArray header = QString("HTTP/1.1 %1 %2\r\n").arg(status).arg(reason).toLatin1();
+    header += "Content-Type: application/json\r\n";
+    header += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    if (!etag.isEmpty()) {
+        header += "ETag: " + etag + "\r\n";
+        header += "Cache-Control: max-age=0\r\n";
+    }
+    header += "Connection: close\r\n\r\n";
+    socket->write(header);
+    writeChunks(socket, body);
+}
+
+void StandInServer::writeChunks(QTcpSocket* socket, QByteArray body)
+{
+    if (m_config.chunkBytes <= 0 || body.size() <= m_config.chunkBytes) {
+        socket->write(body);
+        socket->disconnectFromHost(); // after what is buffered is written
+        return;
+    }
+    socket->write(body.left(m_config.chunkBytes));
+    QByteArray rest = body.mid(m_config.chunkBytes);
+    QPointer<QTcpSocket> client(socket);
+    QTimer::singleShot(m_config.chunkDelayMs, this, [this, client, rest]() {
+        if (client) writeChunks(client, rest);
+    });
+}
+
+QByteArray StandInServer::padding() const
+{
+    return QByteArray(m_config.paddingBytes, 'x');
+}
+
+QByteArray StandInServer::responseBody(const QString& path, int count)
+{
+    // Built once per route and count; a null array is an unknown route
+    QString key = path + "#" + QString::number(count);
+    auto cached = m_bodies.constFind(key);
+    if (cached != m_bodies.constEnd()) return cached.value();
+    
+    static const char* const difficulties[] = {"easy", "medium", "hard"};
+    QString filler = QString::fromLatin1(padding());
+    QJsonObject response;
+    if (path == "/v2/top-headlines") {
+        QJsonArray articles;
+        for (int i = 0; i < count; ++i) {
+            QJsonObject source;
+            source["id"] = QJsonValue();
+            source["name"] = "Stand-in";
+            QJsonObject article;
+            article["source"] = source;
+            article["title"] = QString("Stand-in headline %1").arg(i)
+                + QString(" with more detail").repeated(i % 7);
+            article["description"] = QString("Summary of stand-in story %1.").arg(i);
+            article["content"] = filler;
+            article["publishedAt"] = "2024-05-01T12:00:00Z";
+            articles.append(article);
+        }
+        response["status"] = "ok";
+        response["totalResults"] = count;
+        response["articles"] = articles;
+    } else if (path == "/api.php") {
+        auto encode = [](const QString& text) {
+            return QString::fromLatin1(QUrl::toPercentEncoding(text));
+        };
+        QJsonArray results;
+        for (int i = 0; i < count; ++i) {
+            QJsonObject trivia;
+            trivia["type"] = "multiple";
+            trivia["difficulty"] = difficulties[i % 3];
+            trivia["category"] = encode("Stand-in Knowledge");
+            trivia["question"] = encode(QString("Which answer belongs to stand-in question %1?").arg(i));
+            trivia["correct_answer"] = encode(QString("Answer %1").arg(i));
+            QJsonArray incorrect;
+            for (int option = 1; option <= 3; ++option) {
+                incorrect.append(encode(QString("Distractor %1.%2").arg(i).arg(option)));
+            }
+            trivia["incorrect_answers"] = incorrect;
+            trivia["padding"] = filler;
+            results.append(trivia);
+        }
+        response["response_code"] = 0;
+        response["results"] = results;
+    } else if (path == "/problems/get-problems") {
+        static const char* const levels[] = {"Easy", "Medium", "Hard"};
+        QJsonArray results;
+        for (int i = 0; i < count; ++i) {
+            QJsonObject problem;
+            problem["title"] = QString("Stand-in problem %1").arg(i);
+            problem["difficulty"] = levels[i % 3];
+            problem["padding"] = filler;
+            results.append(problem);
+        }
+        response["status"] = "SUCCESS";
+        response["results"] = results;
+    } else {
+        return QByteArray();
+    }
+    QByteArray body = QJsonDocument(response).toJson(QJsonDocument::Compact);
+    m_bodies.insert(key, body);
+    return body;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef STANDINSERVER_H
+#define STANDINSERVER_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QHash>
+#include <QUrl>
+#include <QByteArray>
+#include <random>
+
+class QTcpSocket;
+
+// Local HTTP server that answers like the built-in providers, for
+// repeatable fetch measurements without the network. Point a source at
+// providerUrl() with ApiManager::configureProvider(name, {{"url", ...}}).
+//
+// Routes, each shaped like the real response:
+//   /v2/top-headlines       NewsAPI articles, pageSize of them
+//   /api.php                Open Trivia DB questions, percent-encoded, amount of them
+//   /problems/get-problems  GeeksforGeeks problems
+// Anything else is a 404. Bodies depend only on the route, the count and
+// the configuration, so every run sees the same bytes. Each response
+// carries an ETag and max-age=0; a matching If-None-Match gets a 304.
+// One request per connection.
+class StandInServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Config {
+        int latencyMs = 0;    // before the first byte of a response
+        int items = 50;       // elements per response, unless asked for fewer
+        int paddingBytes = 0; // extra text per element
+        double errorRate = 0.0; // share of requests answered 503
+        int chunkBytes = 0;   // body written in pieces this big; 0: at once
+        int chunkDelayMs = 0; // between pieces
+        quint32 seed = 1;     // which requests fail
+    };
+
+    struct Stats {
+        qint64 requests = 0;
+        qint64 served = 0;      // 200s
+        qint64 notModified = 0; // 304s
+        qint64 errors = 0;      // 503s
+        qint64 notFound = 0;    // 404s
+        qint64 bodyBytes = 0;
+    };
+
+    explicit StandInServer(const Config& config = Config(), QObject *parent = nullptr);
+
+    // Port 0 picks a free one
+    bool listen(quint16 port = 0);
+    quint16 port() const;
+    QUrl baseUrl() const;
+    // Endpoint standing in for a built-in provider; empty for other names
+    QUrl providerUrl(const QString& name) const;
+
+    void setConfig(const Config& config);
+    Config config() const;
+    Stats stats() const;
+    void resetStats();
+
+private slots:
+    void onNewConnection();
+
+private:
+    void handleRequest(QTcpSocket* socket, const QByteArray& head);
+    void respond(QTcpSocket* socket, int status, const QByteArray& etag, const QByteArray& body);
+    void writeChunks(QTcpSocket* socket, QByteArray body);
+    QByteArray responseBody(const QString& path, int count);
+    QByteArray padding() const;
+
+    QTcpServer m_server;
+    Config m_config;
+    Stats m_stats;
+    std::mt19937 m_rng;
+    QHash<QTcpSocket*, QByteArray> m_heads;  // request bytes so far
+    QHash<QString, QByteArray> m_bodies;     // by route and count
+};
+
+#endif // STANDINSERVER_H
\ No newline at end of file
@@ -46,8 +46,9 @@ TimerWidget::TimerWidget(QWidget *parent)
     layout->addWidget(m_timeLabel);
     layout->addWidget(m_progressBar);
     
-    // Setup timer
-    m_timer->setInterval(1000); // 1 second
+    // Refresh timer: re-armed after each refresh, never ticks on its own
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
     connect(m_timer, &QTimer::timeout, this, &TimerWidget::updateDisplay);
     
     setFixedSize(200, 100);
@@ -67,7 +68,20 @@ TimerWidget::~TimerWidget()
 void TimerWidget::setTime(int seconds)
 {
     m_totalTime = seconds;
-    m_remainingTime = seconds;
+    if (!m_timeSource) {
+        m_remainingTime = seconds;
+    }
+    updateDisplay();
+}
+
+void TimerWidget::setTimeSource(const std::function<qint64()>& remainingMs)
+{
+    m_timeSource = remainingMs;
+    refresh();
+}
+
+void TimerWidget::refresh()
+{
     updateDisplay();
 }
 
@@ -77,7 +91,7 @@ void TimerWidget::startTimer()
     
     m_isRunning = true;
     m_isPaused = false;
-    m_timer->start();
+    updateDisplay();
 }
 
 void TimerWidget::stopTimer()
@@ -100,7 +114,7 @@ void TimerWidget::resumeTimer()
     if (!m_isRunning || !m_isPaused) return;
     
     m_isPaused = false;
-    m_timer->start();
+    updateDisplay();
 }
 
 void TimerWidget::setPaused(bool paused)
@@ -122,14 +136,26 @@ int TimerWidget::getRemainingTime() const
     return m_remainingTime;
 }
 
+void TimerWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    updateDisplay();
+}
+
 void TimerWidget::updateDisplay()
 {
-    if (m_remainingTime <= 0) {
-        m_remainingTime = 0;
+    // Poll the deadline; without a source show the last time set
+    qint64 remainingMs = m_timeSource ? qMax<qint64>(0, m_timeSource())
+                                      : static_cast<qint64>(m_remainingTime) * 1000;
+    m_remainingTime = static_cast<int>((remainingMs + 999) / 1000);
+    
+    if (m_remainingTime <= 0 && m_isRunning) {
         stopTimer();
         emit timeUp();
-    } else {
-        m_remainingTime--;
+    } else if (m_isRunning && !m_isPaused && isVisible() && m_timeSource) {
+        // Next refresh when the displayed second changes
+        int untilNextSecond = static_cast<int>(remainingMs % 1000);
+        m_timer->start(untilNextSecond > 0 ? untilNextSecond : 1000);
     }
     
     m_timeLabel->setText(formatTime(m_remainingTime));
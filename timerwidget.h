@@ -7,7 +7,11 @@
 #include <QProgressBar>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include <functional>
 
+// Shows the time left on a deadline owned elsewhere. The widget keeps no
+// countdown of its own: it polls its time source when it refreshes, and
+// only schedules the next refresh for when the shown second changes.
 class TimerWidget : public QWidget
 {
     Q_OBJECT
@@ -16,7 +20,9 @@ public:
     explicit TimerWidget(QWidget *parent = nullptr);
     ~TimerWidget();
 
-    void setTime(int seconds);
+    void setTime(int seconds); // total time, for the progress bar
+    void setTimeSource(const std::function<qint64()>& remainingMs);
+    void refresh();
     void startTimer();
     void stopTimer();
     void pauseTimer();
@@ -28,13 +34,17 @@ public:
 signals:
     void timeUp();
 
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private slots:
     void updateDisplay();
 
 private:
     QLabel* m_timeLabel;
     QProgressBar* m_progressBar;
-    QTimer* m_timer;
+    QTimer* m_timer; // single-shot, fires when the shown second changes
+    std::function<qint64()> m_timeSource;
     int m_remainingTime;
     int m_totalTime;
     bool m_isRunning;
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Compiles a JSON question bank into a C++ header of constexpr records.
+
+Usage: genbank.py <bank.json> <output.h>
+
+The input has the shape of a JSON custom quiz:
+    {"name": "cpp_dsa", "questions": [{"question": ..., "options": [...],
+     "correctAnswer": ..., "difficulty": "Easy|Medium|Hard",
+     "type": "multiple|boolean"}]}
+
+The output defines <name>Bank, a BuiltinBank (see builtinbanks.h) whose
+strings are UTF-16 literals wrapped in QStringView, so nothing is built or
+allocated for the bank at run time. The header is only rewritten when its
+contents change, so an unchanged bank does not trigger a rebuild.
+"""
+
+import json
+import os
+import re
+import sys
+
+DIFFICULTIES = {"Easy": "Difficulty::Easy", "Medium": "Difficulty::Medium", "Hard": "Difficulty::Hard"}
+TYPES = {"multiple": "QuestionType::MultipleChoice", "boolean": "QuestionType::TrueFalse"}
+
+
+def fail(path, message):
+    sys.exit("%s: %s" % (path, message))
+
+
+def literal(text):
+    """A QStringView over a u"" literal, its UTF-16 length spelled out."""
+    out = []
+    for ch in text:
+        code = ord(ch)
+        if ch in '"\\':
+            out.append("\\" + ch)
+        elif 0x20 <= code < 0x7f:
+            out.append(ch)
+        elif code <= 0xffff:
+            out.append("\\u%04x" % code)
+        else:
+            out.append("\\U%08x" % code)
+    length = len(text.encode("utf-16-le")) // 2
+    return 'QStringView(u"%s", %d)' % ("".join(out), length)
+
+
+def generate(source):
+    with open(source, encoding="utf-8") as f:
+        bank = json.load(f)
+
+    name = bank.get("name") or os.path.splitext(os.path.basename(source))[0]
+    if not re.fullmatch(r"[A-Za-z_][A-Za-z0-9_]*", name):
+        fail(source, "bank name %r is not an identifier" % name)
+    questions = bank.get("questions")
+    if not isinstance(questions, list) or not questions:
+        fail(source, "no questions")
+
+    lines = [
+        "// Generated by tools/genbank.py from %s. Do not edit." % os.path.basename(source),
+        "",
+        "#include \"builtinbanks.h\"",
+        "",
+    ]
+    records = []
+    for index, question in enumerate(questions):
+        where = "question %d" % index
+        options = question.get("options", [])
+        answer = question.get("correctAnswer")
+        if not question.get("question") or not options:
+            fail(source, "%s: needs question text and options" % where)
+        if len(options) > 127:
+            fail(source, "%s: too many options" % where)
+        if answer not in options:
+            fail(source, "%s: correct answer %r is not one of the options" % (where, answer))
+        difficulty = DIFFICULTIES.get(question.get("difficulty", "Easy"))
+        kind = TYPES.get(question.get("type", "multiple"))
+        if difficulty is None or kind is None:
+            fail(source, "%s: unknown difficulty or type" % where)
+
+        lines.append("static constexpr QStringView %sOptions%d[] = {" % (name, index))
+        lines.extend("    %s," % literal(option) for option in options)
+        lines.append("};")
+        records.append("    {%s, %sOptions%d, %d, %d, %s, %s}," % (
+            literal(question["question"]), name, index, len(options),
+            options.index(answer), difficulty, kind))
+
+    lines.append("")
+    lines.append("static constexpr BuiltinQuestion %sQuestions[] = {" % name)
+    lines.extend(records)
+    lines.append("};")
+    lines.append("")
+    lines.append("static constexpr BuiltinBank %sBank = {%sQuestions, %d};" % (name, name, len(records)))
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    source, output = sys.argv[1], sys.argv[2]
+    contents = generate(source)
+
+    try:
+        with open(output, encoding="utf-8") as f:
+            if f.read() == contents:
+                return
+    except OSError:
+        pass
+    with open(output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(contents)
+
+
+if __name__ == "__main__":
+    main()